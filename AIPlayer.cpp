@@ -1,170 +1,425 @@
 #include "AIPlayer.h"
+#include "Logger.h"
 #include <algorithm>
-#include <climits>
-#include <iostream>
 #include <chrono>
+#include <thread>
 using namespace std;
 
-GameState::GameState(const vector<vector<Player>>& boardState, Player player) 
-    : board(boardState), currentPlayer(player), score(0), parent(nullptr) {
+template <int Rows, int Cols, int K>
+AIPlayer<Rows, Cols, K>::AIPlayer(Player aiPlayer, Difficulty difficulty, uint32_t seed) 
+    : aiPlayer(aiPlayer), current(0), currentTransform(0),
+      difficulty(difficulty), rng(seed), verbose(true), useSolvedTable(IS_CLASSIC),
+      telemetryEnabled(true), lastPath(MovePath::RANDOM) {
+    
+    humanPlayer = (aiPlayer == Player::X) ? Player::O : Player::X;
+    mctsLimits.threads = max(1u, thread::hardware_concurrency());
+    
+    if constexpr (IS_CLASSIC) {
+        tree = GameTree::shared();
+        current = tree->getRoot();
+    } else {
+        // Sem tabela resolvida: a Difícil busca com prazo fixo por jogada, em todos os núcleos
+        searchLimits.timeBudget = chrono::milliseconds(500);
+        searchLimits.threads = max(1u, thread::hardware_concurrency());
+        mctsLimits.timeBudget = chrono::milliseconds(500);
+    }
 }
 
-GameState::~GameState() {
-    for (auto child : children) {
-        delete child;
-    }
+template <int Rows, int Cols, int K>
+AIPlayer<Rows, Cols, K>::~AIPlayer() {
 }
 
-AIPlayer::AIPlayer(Player aiPlayer, Difficulty difficulty) 
-    : aiPlayer(aiPlayer), difficulty(difficulty), root(nullptr), current(nullptr) {
-    
-    humanPlayer = (aiPlayer == Player::X) ? Player::O : Player::X;
-    
-    random_device rd;
-    rng = mt19937(rd());
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setDifficulty(Difficulty newDifficulty) {
+    difficulty = newDifficulty;
+    if (verbose) LOG_INFO("IA: Dificuldade alterada para {}",
+                          difficulty == Difficulty::EASY ? "FACIL" :
+                          difficulty == Difficulty::MEDIUM ? "MEDIO" :
+                          difficulty == Difficulty::HARD ? "DIFICIL" : "MCTS");
+    ponderCache.clear();
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setMCTSLimits(const MCTSLimits& limits) {
+    mctsLimits = limits;
+    ponderCache.clear();
+}
+
+template <int Rows, int Cols, int K>
+const MCTSLimits& AIPlayer<Rows, Cols, K>::getMCTSLimits() const {
+    return mctsLimits;
+}
+
+template <int Rows, int Cols, int K>
+const MCTSStats& AIPlayer<Rows, Cols, K>::getMCTSStats() const {
+    return mcts.getStats();
 }
 
-AIPlayer::~AIPlayer() {
-    if (root) {
-        delete root;  // Libera toda a árvore persistente
+template <int Rows, int Cols, int K>
+bool AIPlayer<Rows, Cols, K>::loadEndgameDatabase(const string& directory) {
+    if constexpr (IS_CLASSIC || !EndgameDatabase<Rows, Cols, K>::SUPPORTED) {
+        return false; // o 3x3 já tem a tabela resolvida; os grandes não cabem no banco
+    } else {
+        bool loaded = endgame.open(directory);
+        if (verbose && loaded) {
+            LOG_INFO("Banco de finais {}x{} carregado de {}", Rows, Cols, directory);
+        }
+        return loaded;
     }
 }
 
-void AIPlayer::setDifficulty(Difficulty newDifficulty) {
-    difficulty = newDifficulty;
-    cout << "IA: Dificuldade alterada para " 
-              << (difficulty == Difficulty::EASY ? "FACIL" : 
-                  difficulty == Difficulty::MEDIUM ? "MEDIO" : "DIFICIL") 
-              << endl;
+template <int Rows, int Cols, int K>
+bool AIPlayer<Rows, Cols, K>::loadPositionBook(const string& directory) {
+    if constexpr (!PositionBook<Rows, Cols, K>::SUPPORTED) {
+        return false;
+    } else {
+        string path = book::bookPath(directory, Rows, Cols, K);
+        bool loaded = positionBook.open(path);
+        if (verbose && loaded) LOG_INFO("Livro de posições mapeado: {}", path);
+        return loaded;
+    }
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setSeed(uint32_t seed) {
+    rng.seed(seed);
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setVerbose(bool enabled) {
+    verbose = enabled;
 }
 
+template <int Rows, int Cols, int K>
+const Telemetry& AIPlayer<Rows, Cols, K>::getTelemetry() const {
+    return telemetry;
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setTelemetryEnabled(bool enabled) {
+    telemetryEnabled = enabled;
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setUseSolvedTable(bool enabled) {
+    useSolvedTable = enabled;
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setSearchLimits(const SearchLimits& limits) {
+    searchLimits = limits;
+    ponderCache.clear();
+}
+
+template <int Rows, int Cols, int K>
+const SearchLimits& AIPlayer<Rows, Cols, K>::getSearchLimits() const {
+    return searchLimits;
+}
+
+template <int Rows, int Cols, int K>
+const SearchStats& AIPlayer<Rows, Cols, K>::getSearchStats() const {
+    return engine.getStats();
+}
 
 /*
  * @brief Reinicia a árvore para um novo jogo
  */
-void AIPlayer::resetTree() {
-    if (root) {
-        delete root;  // Libera árvore antiga
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::resetTree() {
+    // A árvore é compartilhada e imutável: basta voltar o cursor para a raiz
+    if constexpr (IS_CLASSIC) {
+        current = tree->getRoot();
     }
+    position.reset();
+    currentTransform = 0;
+    mcts.reset();
+    ponderCache.clear();
     
-    // Cria novo estado inicial
-    vector<vector<Player>> emptyBoard(3, 
-        vector<Player>(3, Player::NONE));
-    
-    root = new GameState(emptyBoard, Player::X);
-    current = root;
-    
-    // Constrói árvore completa apenas uma vez
-    buildGameTree(root, 6);
-    cout << "Árvore persistente construída" << endl;
+    if (verbose) LOG_INFO("Árvore persistente reiniciada");
+}
+
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::setSide(Player player) {
+    aiPlayer = player;
+    humanPlayer = getOpponent(player);
+    ponderCache.clear();
+}
+
+template <int Rows, int Cols, int K>
+bool AIPlayer<Rows, Cols, K>::isFinished() const {
+    return position.isGameOver();
 }
 
 /*
- * @brief Atualiza a árvore com a jogada realizada - mantém estrutura
+ * @brief Chamado pela thread dona antes de despachar a busca, nunca durante:
+ * um stopSearch que chegue depois vale mesmo que a busca ainda não tenha começado
+ */
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::prepareSearch() {
+    ponderStopped = false;
+    engine.prepare();
+    mcts.prepare();
+    ponderMcts.prepare();
+}
+
+/*
+ * @brief Só marca as buscas para pararem; a jogada sai normalmente de getBestMove
+ */
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::stopSearch() {
+    ponderStopped = true;
+    engine.stop();
+    mcts.stop();
+    ponderMcts.stop();
+}
+
+/*
+ * @brief Aproveita a vez do adversário: busca a resposta a cada jogada dele,
+ * começando pela mais provável, com o mesmo orçamento de uma jogada normal
+ *
+ * As respostas ficam em ponderCache, indexadas pela posição que a jogada do
+ * adversário cria, e getBestMove as devolve sem buscar. Só a Difícil com
+ * motor de busca e a Monte Carlo pensam; as outras já respondem na hora.
+ * A Monte Carlo pensa em ponderMcts: a árvore de mcts continua na posição
+ * real e é reaproveitada por updateTree quando a resposta não estava pronta.
+ * Roda até cobrir todas as jogadas ou até stopSearch().
  */
-void AIPlayer::updateTree(const pair<int, int>& move) {
-    // Se não temos árvore ainda, constrói
-    if (root == nullptr) {
-        resetTree();
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::ponder() {
+    ponderCache.clear();
+    
+    bool searches = (difficulty == Difficulty::HARD && !hasExactMoves()) || difficulty == Difficulty::MCTS;
+    if (!searches || position.isGameOver() || position.sideToMove() != humanPlayer) {
         return;
     }
     
-    // Procura o filho que corresponde à jogada realizada e muda para ele
-    for (GameState* child : current->children) {
-        pair<int, int> childMove = findMoveDifference(current->board, child->board);
-        if (childMove.first == move.first && childMove.second == move.second) {
-            current = child;
-            cout << "Árvore atualizada: navegou para nó filho (" 
-                      << move.first << "," << move.second << ")" << endl;
-            return;
+    // Jogada prevista do adversário primeiro: busca rasa a partir da posição atual
+    SearchLimits quick;
+    quick.maxNodes = 20000;
+    int predicted = engine.search(position.getBoard(), quick);
+    
+    vector<int> replies;
+    if (predicted >= 0) replies.push_back(predicted);
+    typename Board::Mask candidates = position.getBoard().candidateMoves();
+    while (anyBit(candidates)) {
+        int cell = lowestBit(candidates);
+        clearLowest(candidates);
+        if (cell != predicted) replies.push_back(cell);
+    }
+    
+    for (int cell : replies) {
+        if (ponderStopped) break;
+        position.makeMove(cell, humanPlayer);
+        if (!position.isGameOver()) {
+            pair<int, int> reply = difficulty == Difficulty::HARD ? getHardMove() : getMCTSMove(ponderMcts);
+            // Busca interrompida no meio não vale como resposta
+            if (!ponderStopped) ponderCache.push_back({position.getBoard(), reply});
         }
+        position.unmakeMove();
     }
     
-    // Jogada não encontrada
-    cout << "AVISO: Jogada (" << move.first << "," << move.second 
-              << ") não encontrada na árvore. Reiniciando árvore..." << endl;
-    resetTree();
+    if (verbose) LOG_INFO("IA: {} respostas calculadas antecipadamente", ponderCache.size());
 }
 
 /*
- * @brief Calcula melhor jogada usando árvore
+ * @brief Atualiza a árvore com a jogada realizada - mantém estrutura
  */
-pair<int, int> AIPlayer::getBestMove() {
-    // Se não temos árvore, constrói
-    if (root == nullptr) {
-        resetTree();
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::updateTree(const pair<int, int>& move) {
+    if (move.first >= 0 && move.first < Rows && move.second >= 0 && move.second < Cols &&
+        position.getBoard().isEmpty(move.first, move.second) && !position.isGameOver()) {
+        position.makeMove(Board::index(move.first, move.second), sideToMove());
+        
+        if constexpr (IS_CLASSIC) {
+            // O filho correspondente é localizado pelo índice da forma canônica da posição resultante
+            int transform;
+            uint32_t child = tree->find(position.getBoard().canonical(transform));
+            if (child == GameTree::NO_NODE) {
+                position.unmakeMove();
+                return;
+            }
+            current = child;
+            currentTransform = transform;
+        }
+        // A busca Monte Carlo reaproveita a subárvore da jogada feita
+        mcts.advance(position.getBoard(), Board::index(move.first, move.second));
+        if (verbose) LOG_INFO("Árvore atualizada: navegou para nó filho ({},{})", move.first, move.second);
+        return;
     }
     
+    // Jogada inválida: a árvore continua na posição atual em vez de ser reconstruída
+    if (verbose) LOG_WARN("Jogada ({},{}) inválida na posição atual. Árvore mantida.", move.first, move.second);
+}
+
+/*
+ * @brief Calcula melhor jogada usando árvore e registra o custo da decisão
+ */
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getBestMove() {
+    if (!telemetryEnabled) return chooseMove();
+    auto start = chrono::steady_clock::now();
+    pair<int, int> move = chooseMove();
+    recordDecision(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+    return move;
+}
+
+template <int Rows, int Cols, int K>
+MovePath AIPlayer<Rows, Cols, K>::getLastPath() const {
+    return lastPath;
+}
+
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::chooseMove() {
     // Verifica se é a vez da IA no estado atual
-    if (current->currentPlayer != aiPlayer) {
+    lastPath = MovePath::RANDOM;
+    if (sideToMove() != aiPlayer) {
         return getRandomMove();
     }
     
+    // Resposta já calculada por ponder() durante a vez do adversário
+    for (const auto& entry : ponderCache) {
+        if (entry.first == position.getBoard()) {
+            lastPath = MovePath::PONDER;
+            return entry.second;
+        }
+    }
+    
     // Delega para estratégia baseada na dificuldade
     switch(difficulty) {
         case Difficulty::EASY:
+            lastPath = MovePath::EASY;
             return getEasyMove();
         case Difficulty::MEDIUM:
+            lastPath = MovePath::MEDIUM;
             return getMediumMove();
         case Difficulty::HARD:
             return getHardMove();
+        case Difficulty::MCTS:
+            return getMCTSMove(mcts);
         default:
             return getRandomMove();
     }
 }
 
-// ==================== ESTRATÉGIAS USANDO ÁRVORE PERSISTENTE ====================
-
-pair<int, int> AIPlayer::getHardMove() {
-    if (current == nullptr || current->children.empty()) {
-        return getRandomMove();
-    }
+/*
+ * @brief Monta o registro da decisão: contadores da busca só valem para o
+ * caminho que de fato buscou; memória inclui a árvore compartilhada do 3x3
+ */
+template <int Rows, int Cols, int K>
+void AIPlayer<Rows, Cols, K>::recordDecision(int64_t latencyMicros) {
+    MoveRecord move;
+    move.difficulty = uint8_t(difficulty);
+    move.path = lastPath;
+    move.ply = position.getPly();
+    move.latencyMicros = latencyMicros;
+    move.ponderHit = lastPath == MovePath::PONDER;
     
-    int bestScore = INT_MIN;
-    pair<int, int> bestMove = {-1, -1};
-    vector<pair<int, int>> bestMoves;
+    if (lastPath == MovePath::SEARCH) {
+        const SearchStats& stats = engine.getStats();
+        move.nodesVisited = stats.nodes;
+        move.ttProbes = stats.ttProbes;
+        move.ttHits = stats.ttHits;
+    } else if (lastPath == MovePath::MCTS) {
+        const MCTSStats& stats = mcts.getStats();
+        move.nodesVisited = stats.playouts;
+        move.nodesBuilt = stats.nodes - stats.reusedNodes;
+    }
     
-    // Avalia cada jogada possível a partir do estado atual
-    for (GameState* child : current->children) {
-        int score = minimax(child, 6, false);
-        
-        if (score > bestScore) {
-            bestScore = score;
-            bestMoves.clear();
-            bestMoves.push_back(findMoveDifference(current->board, child->board));
-        } else if (score == bestScore) {
-            bestMoves.push_back(findMoveDifference(current->board, child->board));
+    move.treeNodes = mcts.treeNodes();
+    move.bytesHeld = engine.memoryBytes() + mcts.memoryBytes() + ponderMcts.memoryBytes() +
+                     ponderCache.capacity() * sizeof(ponderCache[0]);
+    if constexpr (IS_CLASSIC) {
+        move.treeNodes += tree->size();
+        move.bytesHeld += tree->memoryBytes();
+    }
+    telemetry.record(move);
+}
+
+// ==================== ESTRATÉGIAS USANDO ÁRVORE PERSISTENTE ====================
+
+/*
+ * @brief Jogada perfeita com uma única consulta ao livro mapeado, à tabela
+ * resolvida ou ao banco de finais, ou pelo motor de busca dentro do orçamento
+ */
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getHardMove() {
+    if constexpr (PositionBook<Rows, Cols, K>::SUPPORTED) {
+        typename Board::Mask bestMoves = 0;
+        if (positionBook.isOpen()) {
+            bestMoves = positionBook.bestMoves(position.getBoard());
+            lastPath = MovePath::BOOK;
+        } else if (!IS_CLASSIC && endgame.isOpen()) {
+            bestMoves = endgame.bestMoves(position.getBoard());
+            lastPath = MovePath::ENDGAME;
+        }
+        if (anyBit(bestMoves)) {
+            // Sorteia entre as jogadas ótimas para a IA não ficar previsível
+            uniform_int_distribution<int> dist(0, bitCount(bestMoves) - 1);
+            for (int skip = dist(rng); skip > 0; --skip) {
+                clearLowest(bestMoves);
+            }
+            int cell = lowestBit(bestMoves);
+            return {cell / Cols, cell % Cols};
         }
     }
     
-    if (!bestMoves.empty()) {
-        uniform_int_distribution<int> dist(0, bestMoves.size() - 1);
-        return bestMoves[dist(rng)];
+    if constexpr (IS_CLASSIC) {
+        if (useSolvedTable) {
+            lastPath = MovePath::SOLVED_TABLE;
+            uint16_t bestMoves = solvedEntry(position.getBoard().rank()).bestMoves;
+            if (bestMoves == 0) {
+                return getRandomMove();
+            }
+            
+            // Sorteia entre as jogadas ótimas para a IA não ficar previsível
+            uniform_int_distribution<int> dist(0, __builtin_popcount(bestMoves) - 1);
+            for (int skip = dist(rng); skip > 0; --skip) {
+                bestMoves &= bestMoves - 1;
+            }
+            int cell = __builtin_ctz(bestMoves);
+            return {cell / 3, cell % 3};
+        }
     }
     
-    return getRandomMove();
+    lastPath = MovePath::SEARCH;
+    int cell = engine.search(position.getBoard(), searchLimits);
+    if (cell < 0) return getRandomMove();
+    return {cell / Cols, cell % Cols};
 }
 
-pair<int, int> AIPlayer::getMediumMove() {
-    if (current == nullptr) return getRandomMove();
-    
-    auto moves = getAvailableMoves(current->board);
+/*
+ * @brief Busca Monte Carlo; a semente vem do gerador da IA para a partida ser reprodutível
+ * @param searcher mcts na vez da IA, ponderMcts no ponder (a raiz de mcts continua a da partida)
+ */
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getMCTSMove(MCTSEngine<Rows, Cols, K>& searcher) {
+    lastPath = MovePath::MCTS;
+    int cell = searcher.search(position.getBoard(), mctsLimits, uint32_t(rng()));
+    if (cell < 0) return getRandomMove();
+    return {cell / Cols, cell % Cols};
+}
+
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getMediumMove() {
+    auto moves = getAvailableMoves(position.getBoard());
     if (moves.empty()) return {-1, -1};
     
-    // 1. Tenta vitória imediata
+    // 1. Tenta vitória imediata (joga e desfaz no lugar, sem copiar o tabuleiro)
     for (const auto& move : moves) {
-        auto testBoard = current->board;
-        testBoard[move.first][move.second] = aiPlayer;
-        if (checkWinner(testBoard) == aiPlayer) {
+        position.makeMove(Board::index(move.first, move.second), aiPlayer);
+        bool wins = position.getWinner() == aiPlayer;
+        position.unmakeMove();
+        if (wins) {
             return move;
         }
     }
     
     // 2. Tenta bloquear jogador
     for (const auto& move : moves) {
-        auto testBoard = current->board;
-        testBoard[move.first][move.second] = humanPlayer;
-        if (checkWinner(testBoard) == humanPlayer) {
+        position.makeMove(Board::index(move.first, move.second), humanPlayer);
+        bool loses = position.getWinner() == humanPlayer;
+        position.unmakeMove();
+        if (loses) {
             return move;
         }
     }
@@ -172,13 +427,13 @@ pair<int, int> AIPlayer::getMediumMove() {
     // 3. Estratégia posicional com aleatoriedade
     vector<pair<int, int>> goodMoves;
     
-    if (current->board[1][1] == Player::NONE) {
-        goodMoves.push_back({1, 1});
+    if (position.getBoard().isEmpty(Rows / 2, Cols / 2)) {
+        goodMoves.push_back({Rows / 2, Cols / 2});
     }
     
-    vector<pair<int, int>> corners = {{0,0}, {0,2}, {2,0}, {2,2}};
+    vector<pair<int, int>> corners = {{0,0}, {0,Cols-1}, {Rows-1,0}, {Rows-1,Cols-1}};
     for (const auto& corner : corners) {
-        if (current->board[corner.first][corner.second] == Player::NONE) {
+        if (position.getBoard().isEmpty(corner.first, corner.second)) {
             goodMoves.push_back(corner);
         }
     }
@@ -193,10 +448,9 @@ pair<int, int> AIPlayer::getMediumMove() {
     }
 }
 
-pair<int, int> AIPlayer::getEasyMove() {
-    if (current == nullptr) return getRandomMove();
-    
-    auto moves = getAvailableMoves(current->board);
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getEasyMove() {
+    auto moves = getAvailableMoves(position.getBoard());
     if (moves.empty()) return {-1, -1};
     
     uniform_real_distribution<float> dist(0.0f, 1.0f);
@@ -208,8 +462,9 @@ pair<int, int> AIPlayer::getEasyMove() {
     }
 }
 
-pair<int, int> AIPlayer::getRandomMove() {
-    auto moves = getAvailableMoves(current->board);
+template <int Rows, int Cols, int K>
+pair<int, int> AIPlayer<Rows, Cols, K>::getRandomMove() {
+    auto moves = getAvailableMoves(position.getBoard());
     if (moves.empty()) return {-1, -1};
     
     uniform_int_distribution<int> dist(0, moves.size() - 1);
@@ -218,120 +473,54 @@ pair<int, int> AIPlayer::getRandomMove() {
 
 // ==================== MÉTODOS DA ÁRVORE ====================
 
-void AIPlayer::buildGameTree(GameState* state, int depth) {
-    if (depth == 0 || isGameOver(state->board)) return;
-    
-    auto moves = getAvailableMoves(state->board);
-    for (const auto& move : moves) {
-        vector<vector<Player>> newBoard = state->board;
-        newBoard[move.first][move.second] = state->currentPlayer;
-        
-        GameState* newState = new GameState(newBoard, getOpponent(state->currentPlayer));
-        newState->parent = state;
-        state->children.push_back(newState);
-        
-        buildGameTree(newState, depth - 1);
-    }
+template <int Rows, int Cols, int K>
+bool AIPlayer<Rows, Cols, K>::isGameOver(const Board& board) {
+    return board.isGameOver();
 }
 
-int AIPlayer::minimax(GameState* state, int depth, bool isMaximizing) {
-    if (depth == 0 || state->children.empty() || isGameOver(state->board)) {
-        return evaluateBoard(state->board);
-    }
-    
-    if (isMaximizing) {
-        int bestScore = INT_MIN;
-        for (GameState* child : state->children) {
-            int score = minimax(child, depth - 1, false);
-            bestScore = max(bestScore, score);
-        }
-        return bestScore;
+template <int Rows, int Cols, int K>
+bool AIPlayer<Rows, Cols, K>::hasExactMoves() const {
+    if constexpr (IS_CLASSIC) {
+        return useSolvedTable || positionBook.isOpen();
     } else {
-        int bestScore = INT_MAX;
-        for (GameState* child : state->children) {
-            int score = minimax(child, depth - 1, true);
-            bestScore = min(bestScore, score);
-        }
-        return bestScore;
-    }
-}
-
-bool AIPlayer::isGameOver(const vector<vector<Player>>& board) {
-    if (checkWinner(board) != Player::NONE) return true;
-    
-    for (const auto& row : board) {
-        for (const auto& cell : row) {
-            if (cell == Player::NONE) return false;
-        }
+        return positionBook.isOpen() || endgame.isOpen();
     }
-    return true;
-}
-
-int AIPlayer::evaluateBoard(const vector<vector<Player>>& board) {
-    Player winner = checkWinner(board);
-    if (winner == aiPlayer) return 10;
-    if (winner == humanPlayer) return -10;
-    return 0;
 }
 
-vector<pair<int, int>> AIPlayer::getAvailableMoves(const vector<vector<Player>>& board) {
+template <int Rows, int Cols, int K>
+vector<pair<int, int>> AIPlayer<Rows, Cols, K>::getAvailableMoves(const Board& board) {
     vector<pair<int, int>> moves;
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == Player::NONE) {
-                moves.push_back({i, j});
-            }
-        }
+    typename Board::Mask empty = board.emptyCells();
+    moves.reserve(bitCount(empty));
+    while (anyBit(empty)) {
+        int cell = lowestBit(empty);
+        clearLowest(empty);
+        moves.push_back({cell / Cols, cell % Cols});
     }
     return moves;
 }
 
-Player AIPlayer::getOpponent(Player player) {
+template <int Rows, int Cols, int K>
+Player AIPlayer<Rows, Cols, K>::getOpponent(Player player) {
     return (player == Player::X) ? Player::O : Player::X;
 }
 
-pair<int, int> AIPlayer::findMoveDifference(
-    const vector<vector<Player>>& oldBoard,
-    const vector<vector<Player>>& newBoard) {
-    
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (oldBoard[i][j] != newBoard[i][j]) {
-                return {i, j};
-            }
-        }
+template <int Rows, int Cols, int K>
+Player AIPlayer<Rows, Cols, K>::sideToMove() const {
+    if constexpr (IS_CLASSIC) {
+        return tree->getNode(current).currentPlayer;
+    } else {
+        return position.sideToMove();
     }
-    return {-1, -1};
 }
 
-Player AIPlayer::checkWinner(const vector<vector<Player>>& board) {
-    for (int i = 0; i < 3; ++i) {
-        if (board[i][0] != Player::NONE && 
-            board[i][0] == board[i][1] && 
-            board[i][1] == board[i][2]) {
-            return board[i][0];
-        }
-    }
-    
-    for (int i = 0; i < 3; ++i) {
-        if (board[0][i] != Player::NONE && 
-            board[0][i] == board[1][i] && 
-            board[1][i] == board[2][i]) {
-            return board[0][i];
-        }
-    }
-    
-    if (board[0][0] != Player::NONE && 
-        board[0][0] == board[1][1] && 
-        board[1][1] == board[2][2]) {
-        return board[0][0];
-    }
-    if (board[0][2] != Player::NONE && 
-        board[0][2] == board[1][1] && 
-        board[1][1] == board[2][0]) {
-        return board[0][2];
-    }
-    
-    return Player::NONE;
+template <int Rows, int Cols, int K>
+Player AIPlayer<Rows, Cols, K>::checkWinner(const Board& board) {
+    return board.winner();
 }
 
+// Tabuleiros suportados pelo jogo
+template class AIPlayer<3, 3, 3>;
+template class AIPlayer<4, 4, 4>;
+template class AIPlayer<5, 5, 4>;
+template class AIPlayer<15, 15, 5>;
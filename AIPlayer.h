@@ -2,72 +2,166 @@
 #define AIPLAYER_H
 
 #include "Board.h"
+#include "SolvedTable.h"
+#include "SearchEngine.h"
+#include "MCTSEngine.h"
+#include "EndgameDatabase.h"
+#include "PositionBook.h"
+#include "Position.h"
+#include "GameTree.h"
+#include "Telemetry.h"
 #include <vector>
 #include <utility>
 #include <random>
+#include <atomic>
 
 using namespace std;
 
 enum class Difficulty { 
     EASY,   // IA joga quase aleatoriamente
     MEDIUM, // IA usa estratégia simples com alguns erros
-    HARD    // IA usa Minimax para jogada quase perfeita
+    HARD,   // IA consulta a tabela do jogo resolvido (jogada perfeita)
+    MCTS    // IA usa busca Monte Carlo com orçamento de simulações
 };
 
 /*
- * @struct GameState
- * @brief Representa um nó na árvore de estados do jogo
+ * @class AIPlayerBase
+ * @brief Interface comum das IAs, independente do tamanho do tabuleiro
+ *
+ * Permite ao Game trocar de tabuleiro em tempo de execução; a busca em si
+ * roda dentro de AIPlayer<Rows, Cols, K>, especializada em compilação.
  */
-struct GameState {
-    vector<vector<Player>> board;               // Estado atual do tabuleiro 3x3
-    Player currentPlayer;                       // Jogador que deve jogar neste estado
-    int score;                                  // Avaliação heurística do estado
-    vector<GameState*> children;                // Ponteiros para estados filhos
-    GameState* parent;                          // Ponteiro para estado pai
-    
-    GameState(const vector<vector<Player>>& boardState, Player player);
-    ~GameState();
+class AIPlayerBase {
+public:
+    virtual ~AIPlayerBase() {}
+    
+    virtual void setDifficulty(Difficulty newDifficulty) = 0; // controle de dificuldade.
+    virtual pair<int, int> getBestMove() = 0; // retorna a melhor jogada.
+    virtual MovePath getLastPath() const = 0; // de onde saiu a última jogada de getBestMove (livro, tabela, busca...)
+    virtual void updateTree(const pair<int, int>& move) = 0;
+    virtual void resetTree() = 0; // reinicia a árvore.
+    virtual void setSide(Player player) = 0; // troca o lado jogado pela IA
+    virtual bool isFinished() const = 0; // a posição atual já terminou (vitória ou velha)
+    virtual void prepareSearch() = 0; // antes de despachar getBestMove ou ponder: esquece um stopSearch anterior
+    virtual void stopSearch() = 0; // interrompe getBestMove ou ponder em andamento ou o próximo (de outra thread)
+    virtual void ponder() = 0; // na vez do adversário, calcula a resposta a cada jogada dele
+    
+    // Motor de busca usado pela IA Difícil quando a tabela resolvida está desligada
+    virtual void setUseSolvedTable(bool enabled) = 0;
+    virtual void setSearchLimits(const SearchLimits& limits) = 0;
+    virtual const SearchLimits& getSearchLimits() const = 0;
+    virtual const SearchStats& getSearchStats() const = 0; // estatísticas da última busca
+    
+    // Orçamento da IA Monte Carlo (simulações, tempo e threads)
+    virtual void setMCTSLimits(const MCTSLimits& limits) = 0;
+    virtual const MCTSLimits& getMCTSLimits() const = 0;
+    virtual const MCTSStats& getMCTSStats() const = 0;
+    
+    // Banco de finais do RetrogradeSolver: Difícil perfeita fora do 3x3 (false se faltar)
+    virtual bool loadEndgameDatabase(const string& directory) = 0;
+    // Livro de posições mapeado na memória (diretório/RxCkK.book); tem prioridade sobre o banco
+    virtual bool loadPositionBook(const string& directory) = 0;
+    
+    // Simulação em massa: semente reprodutível e mensagens de console desligadas
+    virtual void setSeed(uint32_t seed) = 0;
+    virtual void setVerbose(bool enabled) = 0;
+    
+    // Custo de cada decisão (caminho, nós, memória, latência) e resumo por dificuldade;
+    // ligada por padrão, desligada na simulação em massa (duas leituras de relógio por jogada)
+    virtual const Telemetry& getTelemetry() const = 0;
+    virtual void setTelemetryEnabled(bool enabled) = 0;
 };
 
 /*
  * @class AIPlayer
  * @brief Implementa a IA usando árvore de decisão persistente
+ *
+ * No 3x3 clássico a IA navega pela árvore compartilhada e a Difícil consulta
+ * a tabela resolvida; nos tabuleiros maiores a Difícil consulta o livro de
+ * posições ou o banco de finais, se carregados, ou usa o motor de busca com
+ * orçamento de tempo por jogada. Com ponder(), as buscas da Difícil e da
+ * Monte Carlo são feitas antes, durante a vez do adversário.
  */
-class AIPlayer {
+template <int Rows, int Cols, int K>
+class AIPlayer : public AIPlayerBase {
 public:
-    AIPlayer(Player aiPlayer, Difficulty difficulty = Difficulty::HARD); // construtor
+    using Board = BitBoard<Rows, Cols, K>;
+    static constexpr bool IS_CLASSIC = (Rows == 3 && Cols == 3 && K == 3);
+    
+    // construtor; a semente padrão vem de random_device (partidas diferentes a cada execução)
+    AIPlayer(Player aiPlayer, Difficulty difficulty = Difficulty::HARD, uint32_t seed = random_device{}());
     ~AIPlayer(); // destrutor.
     
-    void setDifficulty(Difficulty newDifficulty); // controle de dificuldade.
-    pair<int, int> getBestMove(); // retorna a melhor jogada.
-    void updateTree(const pair<int, int>& move);
-    void resetTree(); // reinicia a árvore.
+    void setDifficulty(Difficulty newDifficulty) override;
+    pair<int, int> getBestMove() override;
+    MovePath getLastPath() const override;
+    void updateTree(const pair<int, int>& move) override;
+    void resetTree() override;
+    void setSide(Player player) override;
+    bool isFinished() const override;
+    void prepareSearch() override;
+    void stopSearch() override;
+    void ponder() override;
+    
+    void setUseSolvedTable(bool enabled) override;
+    void setSearchLimits(const SearchLimits& limits) override;
+    const SearchLimits& getSearchLimits() const override;
+    const SearchStats& getSearchStats() const override;
+    
+    void setMCTSLimits(const MCTSLimits& limits) override;
+    const MCTSLimits& getMCTSLimits() const override;
+    const MCTSStats& getMCTSStats() const override;
+    
+    bool loadEndgameDatabase(const string& directory) override;
+    bool loadPositionBook(const string& directory) override;
+    
+    void setSeed(uint32_t seed) override;
+    void setVerbose(bool enabled) override;
+    const Telemetry& getTelemetry() const override;
+    void setTelemetryEnabled(bool enabled) override;
     
 private:
     Player aiPlayer; // jogador IA.
     Player humanPlayer; // jogador humano.
-    GameState* root;        // Raiz persistente da árvore
-    GameState* current;     // Estado atual na árvore
+    shared_ptr<const GameTree> tree; // Árvore persistente, compartilhada (apenas no 3x3)
+    uint32_t current;       // Cursor: estado atual na árvore
+    Position<Rows, Cols, K> position; // Posição real da partida (current guarda a forma canônica)
+    int currentTransform;   // Simetria que leva a posição real até current->board
     Difficulty difficulty; // dificuldade atual.
     mt19937 rng; // gerador de números.
+    bool verbose; // imprime o andamento da árvore no console
+    bool useSolvedTable;        // Difícil consulta a tabela (true) ou busca alfa-beta (false)
+    SearchEngine<Rows, Cols, K> engine; // Motor alfa-beta com aprofundamento iterativo
+    SearchLimits searchLimits;  // Orçamento por jogada do motor
+    MCTSEngine<Rows, Cols, K> mcts; // Busca Monte Carlo; a árvore acompanha a partida
+    MCTSEngine<Rows, Cols, K> ponderMcts; // Só o ponder: as posições hipotéticas não apagam a árvore de mcts
+    MCTSLimits mctsLimits;      // Orçamento por jogada da busca Monte Carlo
+    EndgameDatabase<Rows, Cols, K> endgame; // Banco de finais (só em tabuleiros pequenos)
+    PositionBook<Rows, Cols, K> positionBook; // Livro mapeado: valores e jogadas ótimas
+    vector<pair<Board, pair<int, int>>> ponderCache; // Posição após a jogada do adversário -> resposta
+    atomic<bool> ponderStopped{false}; // stopSearch até o próximo prepareSearch
+    Telemetry telemetry;        // Uma entrada por getBestMove
+    bool telemetryEnabled;
+    MovePath lastPath;          // Caminho da decisão em andamento, marcado pela estratégia
     
     // Métodos da árvore
-    void buildGameTree(GameState* state, int depth);
-    int evaluateBoard(const vector<vector<Player>>& board);
-    int minimax(GameState* state, int depth, bool isMaximizing);
-    vector<pair<int, int>> getAvailableMoves(const vector<vector<Player>>& board);
+    vector<pair<int, int>> getAvailableMoves(const Board& board);
     Player getOpponent(Player player);
-    bool isGameOver(const vector<vector<Player>>& board); 
+    Player sideToMove() const; // jogador da vez na posição atual
+    bool isGameOver(const Board& board); 
+    bool hasExactMoves() const; // a Difícil responde por consulta (livro, tabela ou banco)
     
     // Estratégias por dificuldade
+    pair<int, int> chooseMove(); // escolhe pela dificuldade (getBestMove mede e registra)
+    void recordDecision(int64_t latencyMicros);
     pair<int, int> getRandomMove(); //Escolhe uma jogada 100% aleatória
     pair<int, int> getEasyMove();// Lógica da IA Fácil 
     pair<int, int> getMediumMove();//Lógica da IA Média 
     pair<int, int> getHardMove();// (Privado) Lógica da IA Difícil 
+    pair<int, int> getMCTSMove(MCTSEngine<Rows, Cols, K>& searcher);// Lógica da IA Monte Carlo
     
     // Métodos auxiliares
-    pair<int, int> findMoveDifference(const vector<vector<Player>>& oldBoard, const vector<vector<Player>>& newBoard);
-    Player checkWinner(const vector<vector<Player>>& board); // prevê vitorias futuras.
+    Player checkWinner(const Board& board); // prevê vitorias futuras.
 };
 
 #endif
@@ -0,0 +1,407 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+enum class Player : uint8_t { NONE, X, O };
+
+/*
+ * @struct WideMask
+ * @brief Máscara de bits com mais de 64 casas (ex.: 15x15 do gomoku)
+ *
+ * Guarda Words palavras de 64 bits e oferece as mesmas operações usadas nas
+ * máscaras inteiras, para que o código genérico funcione com os dois tipos.
+ */
+template <int Words>
+struct WideMask {
+    uint64_t w[Words] = {};
+
+    constexpr WideMask operator&(const WideMask& b) const { WideMask r; for (int i = 0; i < Words; ++i) r.w[i] = w[i] & b.w[i]; return r; }
+    constexpr WideMask operator|(const WideMask& b) const { WideMask r; for (int i = 0; i < Words; ++i) r.w[i] = w[i] | b.w[i]; return r; }
+    constexpr WideMask operator^(const WideMask& b) const { WideMask r; for (int i = 0; i < Words; ++i) r.w[i] = w[i] ^ b.w[i]; return r; }
+    constexpr WideMask operator~() const { WideMask r; for (int i = 0; i < Words; ++i) r.w[i] = ~w[i]; return r; }
+    constexpr WideMask& operator&=(const WideMask& b) { for (int i = 0; i < Words; ++i) w[i] &= b.w[i]; return *this; }
+    constexpr WideMask& operator|=(const WideMask& b) { for (int i = 0; i < Words; ++i) w[i] |= b.w[i]; return *this; }
+    constexpr bool operator==(const WideMask& b) const { for (int i = 0; i < Words; ++i) if (w[i] != b.w[i]) return false; return true; }
+    constexpr bool operator!=(const WideMask& b) const { return !(*this == b); }
+
+    // Desloca para as casas de índice menor: o bit i recebe o bit i + s
+    constexpr WideMask operator>>(int s) const {
+        WideMask r;
+        int words = s / 64, bits = s % 64;
+        for (int i = 0; i + words < Words; ++i) {
+            r.w[i] = w[i + words] >> bits;
+            if (bits && i + words + 1 < Words) r.w[i] |= w[i + words + 1] << (64 - bits);
+        }
+        return r;
+    }
+};
+
+// Operações de máscara comuns a inteiros e WideMask
+template <class Mask> constexpr Mask cellBit(int i) {
+    if constexpr (is_integral<Mask>::value) {
+        return Mask(Mask(1) << i);
+    } else {
+        Mask m;
+        m.w[i / 64] = uint64_t(1) << (i % 64);
+        return m;
+    }
+}
+
+template <class Mask> constexpr bool anyBit(const Mask& m) {
+    if constexpr (is_integral<Mask>::value) {
+        return m != 0;
+    } else {
+        for (uint64_t word : m.w) if (word) return true;
+        return false;
+    }
+}
+
+template <class Mask> constexpr bool testBit(const Mask& m, int i) {
+    return anyBit(Mask(m & cellBit<Mask>(i)));
+}
+
+template <class Mask> inline int bitCount(const Mask& m) {
+    if constexpr (is_integral<Mask>::value) {
+        return __builtin_popcountll(uint64_t(m));
+    } else {
+        int count = 0;
+        for (uint64_t word : m.w) count += __builtin_popcountll(word);
+        return count;
+    }
+}
+
+// Índice do bit mais baixo (a máscara não pode ser zero)
+template <class Mask> inline int lowestBit(const Mask& m) {
+    if constexpr (is_integral<Mask>::value) {
+        return __builtin_ctzll(uint64_t(m));
+    } else {
+        int i = 0;
+        while (m.w[i] == 0) ++i;
+        return i * 64 + __builtin_ctzll(m.w[i]);
+    }
+}
+
+template <class Mask> inline void clearLowest(Mask& m) {
+    if constexpr (is_integral<Mask>::value) {
+        m &= Mask(m - 1);
+    } else {
+        for (uint64_t& word : m.w) {
+            if (word) { word &= word - 1; return; }
+        }
+    }
+}
+
+/*
+ * @struct BitBoard
+ * @brief Tabuleiro m,n,k compacto: uma máscara de bits para X e outra para O
+ *
+ * A casa (linha, coluna) corresponde ao bit linha * Cols + coluna. O tipo da
+ * máscara é escolhido em tempo de compilação: até 64 casas cabem em um inteiro
+ * (o 3x3 usa 16 bits, como antes), acima disso usa WideMask. Vence quem
+ * completar K casas em linha, coluna ou diagonal.
+ */
+template <int Rows, int Cols, int K>
+struct BitBoard {
+    static_assert(K >= 1 && K <= Rows && K <= Cols, "K precisa caber no tabuleiro");
+
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr int WIN_LENGTH = K;
+    static constexpr int CELLS = Rows * Cols;
+
+    using Mask = conditional_t<(CELLS <= 16), uint16_t,
+                 conditional_t<(CELLS <= 32), uint32_t,
+                 conditional_t<(CELLS <= 64), uint64_t, WideMask<(CELLS + 63) / 64>>>>;
+
+    Mask x{}; // casas ocupadas por X
+    Mask o{}; // casas ocupadas por O
+
+    static constexpr Mask makeFull() {
+        Mask m{};
+        for (int i = 0; i < CELLS; ++i) m |= cellBit<Mask>(i);
+        return m;
+    }
+    static constexpr Mask FULL = makeFull(); // todas as casas
+
+    // Quantidade de linhas vencedoras: horizontais, verticais e as duas diagonais
+    static constexpr int NUM_LINES = Rows * (Cols - K + 1) + (Rows - K + 1) * Cols +
+                                     2 * (Rows - K + 1) * (Cols - K + 1);
+
+    // Todas as linhas vencedoras pré-calculadas em tempo de compilação
+    static constexpr array<Mask, NUM_LINES> makeWinMasks() {
+        array<Mask, NUM_LINES> lines{};
+        int n = 0;
+        const int dr[4] = { 0, 1, 1, 1 };
+        const int dc[4] = { 1, 0, 1, -1 };
+        for (int d = 0; d < 4; ++d) {
+            for (int r = 0; r < Rows; ++r) {
+                for (int c = 0; c < Cols; ++c) {
+                    int endR = r + dr[d] * (K - 1), endC = c + dc[d] * (K - 1);
+                    if (endR < 0 || endR >= Rows || endC < 0 || endC >= Cols) continue;
+                    Mask m{};
+                    for (int k = 0; k < K; ++k) m |= cellBit<Mask>((r + dr[d] * k) * Cols + c + dc[d] * k);
+                    lines[n++] = m;
+                }
+            }
+        }
+        return lines;
+    }
+    static constexpr array<Mask, NUM_LINES> WIN_MASKS = makeWinMasks();
+
+    // Quantas linhas vencedoras passam por cada casa (centro > cantos > bordas no 3x3)
+    static constexpr array<int, CELLS> makeLinesPerCell() {
+        array<int, CELLS> count{};
+        const int dr[4] = { 0, 1, 1, 1 };
+        const int dc[4] = { 1, 0, 1, -1 };
+        for (int d = 0; d < 4; ++d) {
+            for (int r = 0; r < Rows; ++r) {
+                for (int c = 0; c < Cols; ++c) {
+                    int endR = r + dr[d] * (K - 1), endC = c + dc[d] * (K - 1);
+                    if (endR < 0 || endR >= Rows || endC < 0 || endC >= Cols) continue;
+                    for (int k = 0; k < K; ++k) ++count[(r + dr[d] * k) * Cols + c + dc[d] * k];
+                }
+            }
+        }
+        return count;
+    }
+    static constexpr array<int, CELLS> LINES_PER_CELL = makeLinesPerCell();
+
+    // Índices (em WIN_MASKS) das linhas que passam por cada casa: no máximo K por direção
+    static constexpr int MAX_LINES_PER_CELL = 4 * K;
+    static constexpr array<array<uint16_t, MAX_LINES_PER_CELL>, CELLS> makeCellLines() {
+        array<array<uint16_t, MAX_LINES_PER_CELL>, CELLS> lines{};
+        array<int, CELLS> count{};
+        int n = 0;
+        const int dr[4] = { 0, 1, 1, 1 };
+        const int dc[4] = { 1, 0, 1, -1 };
+        for (int d = 0; d < 4; ++d) {
+            for (int r = 0; r < Rows; ++r) {
+                for (int c = 0; c < Cols; ++c) {
+                    int endR = r + dr[d] * (K - 1), endC = c + dc[d] * (K - 1);
+                    if (endR < 0 || endR >= Rows || endC < 0 || endC >= Cols) continue;
+                    for (int k = 0; k < K; ++k) {
+                        int cell = (r + dr[d] * k) * Cols + c + dc[d] * k;
+                        lines[cell][count[cell]++] = uint16_t(n);
+                    }
+                    ++n;
+                }
+            }
+        }
+        return lines;
+    }
+    static constexpr array<array<uint16_t, MAX_LINES_PER_CELL>, CELLS> CELL_LINES = makeCellLines();
+
+    // Potências de 3 usadas para o índice ternário (0 = vazia, 1 = X, 2 = O)
+    static constexpr int MAX_RANK_CELLS = 20; // 3^20 ainda cabe em 32 bits
+    static constexpr array<uint32_t, CELLS> makePow3() {
+        array<uint32_t, CELLS> p{};
+        uint32_t v = 1;
+        for (int i = 0; i < CELLS && i < MAX_RANK_CELLS; ++i) { p[i] = v; v *= 3; }
+        return p;
+    }
+    static constexpr array<uint32_t, CELLS> POW3 = makePow3();
+    static constexpr uint32_t NUM_RANKS = (CELLS < MAX_RANK_CELLS) ? POW3[CELLS - 1] * 3 : 0;
+
+    // As 8 simetrias do quadrado (grupo D4): SYMMETRIES[t][i] é a casa para onde
+    // a casa i vai na transformação t. Só fazem sentido em tabuleiros quadrados.
+    static constexpr array<array<uint16_t, CELLS>, 8> makeSymmetries() {
+        array<array<uint16_t, CELLS>, 8> s{};
+        const int n = Rows - 1;
+        for (int r = 0; r < Rows; ++r) {
+            for (int c = 0; c < Cols; ++c) {
+                int i = r * Cols + c;
+                s[0][i] = uint16_t(i);                        // identidade
+                s[1][i] = uint16_t(c * Cols + (n - r));       // rotação 90°
+                s[2][i] = uint16_t((n - r) * Cols + (n - c)); // rotação 180°
+                s[3][i] = uint16_t((n - c) * Cols + r);       // rotação 270°
+                s[4][i] = uint16_t(r * Cols + (n - c));       // espelho horizontal
+                s[5][i] = uint16_t((n - r) * Cols + c);       // espelho vertical
+                s[6][i] = uint16_t(c * Cols + r);             // transposta
+                s[7][i] = uint16_t((n - c) * Cols + (n - r)); // antitransposta
+            }
+        }
+        return s;
+    }
+    static constexpr array<array<uint16_t, CELLS>, 8> SYMMETRIES = makeSymmetries();
+    static constexpr uint8_t INVERSE_SYMMETRY[8] = { 0, 3, 2, 1, 4, 5, 6, 7 };
+
+    // Casas vizinhas (as 8 direções) de cada casa
+    static constexpr array<Mask, CELLS> makeNeighbors() {
+        array<Mask, CELLS> masks{};
+        for (int r = 0; r < Rows; ++r) {
+            for (int c = 0; c < Cols; ++c) {
+                for (int dr = -1; dr <= 1; ++dr) {
+                    for (int dc = -1; dc <= 1; ++dc) {
+                        int nr = r + dr, nc = c + dc;
+                        if ((dr || dc) && nr >= 0 && nr < Rows && nc >= 0 && nc < Cols) {
+                            masks[r * Cols + c] |= cellBit<Mask>(nr * Cols + nc);
+                        }
+                    }
+                }
+            }
+        }
+        return masks;
+    }
+    static constexpr array<Mask, CELLS> NEIGHBORS = makeNeighbors();
+
+    // Acima deste tamanho as buscas só consideram casas vizinhas às peças já jogadas
+    static constexpr int NEIGHBORHOOD_CELLS = 25;
+
+    static constexpr int index(int row, int col) { return row * Cols + col; }
+    static constexpr Mask bit(int row, int col) { return cellBit<Mask>(index(row, col)); }
+
+    Mask occupied() const { return x | o; }
+    Mask emptyCells() const { return Mask(~(x | o) & FULL); }
+
+    /*
+     * @brief Casas que valem a pena considerar: todas as vazias nos tabuleiros
+     * pequenos; nos grandes, só as vizinhas de alguma peça (o centro se vazio)
+     */
+    Mask candidateMoves() const {
+        if constexpr (CELLS > NEIGHBORHOOD_CELLS) {
+            Mask stones = occupied();
+            if (!anyBit(stones)) return bit(Rows / 2, Cols / 2);
+            Mask near{};
+            while (anyBit(stones)) {
+                near |= NEIGHBORS[lowestBit(stones)];
+                clearLowest(stones);
+            }
+            return Mask(near & emptyCells());
+        } else {
+            return emptyCells();
+        }
+    }
+    bool isFull() const { return occupied() == FULL; }
+    bool isEmpty(int row, int col) const { return !testBit(occupied(), index(row, col)); }
+
+    Player get(int row, int col) const {
+        int i = index(row, col);
+        if (testBit(x, i)) return Player::X;
+        if (testBit(o, i)) return Player::O;
+        return Player::NONE;
+    }
+
+    void set(int row, int col, Player player) {
+        Mask b = bit(row, col);
+        x &= Mask(~b);
+        o &= Mask(~b);
+        if (player == Player::X) x |= b;
+        else if (player == Player::O) o |= b;
+    }
+
+    // Casas onde uma linha de K casas na direção (dr, dc) pode começar sem sair do tabuleiro
+    static constexpr Mask makeLineStarts(int dr, int dc) {
+        Mask m{};
+        for (int r = 0; r < Rows; ++r) {
+            for (int c = 0; c < Cols; ++c) {
+                int endR = r + dr * (K - 1), endC = c + dc * (K - 1);
+                if (endR >= 0 && endR < Rows && endC >= 0 && endC < Cols) m |= cellBit<Mask>(r * Cols + c);
+            }
+        }
+        return m;
+    }
+
+    /*
+     * @brief Verifica se a máscara contém alguma linha vencedora completa
+     *
+     * Com poucas linhas (3x3, 4x4) elas são testadas uma a uma; em tabuleiros
+     * maiores cada direção é testada de uma vez com K deslocamentos da máscara.
+     */
+    static constexpr bool hasLine(Mask mask) {
+        if constexpr (NUM_LINES <= 16) {
+            for (const Mask& win : WIN_MASKS) {
+                if ((mask & win) == win) return true;
+            }
+            return false;
+        } else {
+            constexpr int shifts[4] = { 1, Cols, Cols + 1, Cols - 1 };
+            constexpr Mask starts[4] = { makeLineStarts(0, 1), makeLineStarts(1, 0),
+                                         makeLineStarts(1, 1), makeLineStarts(1, -1) };
+            for (int d = 0; d < 4; ++d) {
+                Mask run = mask & starts[d];
+                for (int k = 1; k < K && anyBit(run); ++k) {
+                    run &= Mask(mask >> (k * shifts[d]));
+                }
+                if (anyBit(run)) return true;
+            }
+            return false;
+        }
+    }
+
+    Player winner() const {
+        if (hasLine(x)) return Player::X;
+        if (hasLine(o)) return Player::O;
+        return Player::NONE;
+    }
+
+    bool isGameOver() const { return isFull() || winner() != Player::NONE; }
+
+    // Índice ternário denso do tabuleiro, no intervalo [0, NUM_RANKS)
+    uint32_t rank() const {
+        static_assert(CELLS < MAX_RANK_CELLS, "índice ternário só para tabuleiros pequenos");
+        uint32_t r = 0;
+        for (int i = 0; i < CELLS; ++i) {
+            if (testBit(x, i)) r += POW3[i];
+            else if (testBit(o, i)) r += 2 * POW3[i];
+        }
+        return r;
+    }
+
+    static Mask transformMask(const Mask& mask, int t) {
+        Mask result{};
+        Mask rest = mask;
+        while (anyBit(rest)) {
+            int i = lowestBit(rest);
+            clearLowest(rest);
+            result |= cellBit<Mask>(SYMMETRIES[t][i]);
+        }
+        return result;
+    }
+
+    BitBoard transformed(int t) const {
+        BitBoard b;
+        b.x = transformMask(x, t);
+        b.o = transformMask(o, t);
+        return b;
+    }
+
+    /*
+     * @brief Forma canônica do tabuleiro entre as 8 simetrias
+     * @param transform recebe a simetria t tal que transformed(t) == canônico
+     */
+    BitBoard canonical(int& transform) const {
+        static_assert(Rows == Cols && CELLS <= 32, "simetrias D4 só para tabuleiros quadrados pequenos");
+        BitBoard best = *this;
+        uint64_t bestKey = (uint64_t(x) << CELLS) | o;
+        transform = 0;
+        for (int t = 1; t < 8; ++t) {
+            BitBoard b = transformed(t);
+            uint64_t key = (uint64_t(b.x) << CELLS) | b.o;
+            if (key < bestKey) {
+                best = b;
+                bestKey = key;
+                transform = t;
+            }
+        }
+        return best;
+    }
+
+    bool operator==(const BitBoard& other) const { return x == other.x && o == other.o; }
+    bool operator!=(const BitBoard& other) const { return !(*this == other); }
+};
+
+// O jogo da velha clássico
+using Bitboard = BitBoard<3, 3, 3>;
+
+// Jogador da vez em um tabuleiro válido: X começa, então X joga quando as contagens empatam
+template <int Rows, int Cols, int K>
+inline Player playerToMove(const BitBoard<Rows, Cols, K>& board) {
+    return bitCount(board.x) == bitCount(board.o) ? Player::X : Player::O;
+}
+
+#endif
@@ -1,140 +1,173 @@
 #include "Board.h"
 #include <SFML/Graphics.hpp>
+#include <cmath>
 #include <iostream>
-#include <vector>
 using namespace std;
 
-Board::Board() : grid(3, vector<Player>(3, Player::NONE)) {}
+// Geometria do tabuleiro em triângulos, para caber em um único vertex array
+namespace {
 
-void Board::reset() {
-    for (auto& row : grid) {
-        fill(row.begin(), row.end(), Player::NONE);
+const int RING_POINTS = 30; // mesmo número de pontos do sf::CircleShape
+
+void appendQuad(sf::VertexArray& vertices, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d, sf::Color color) {
+    vertices.append(sf::Vertex{a, color});
+    vertices.append(sf::Vertex{b, color});
+    vertices.append(sf::Vertex{c, color});
+    vertices.append(sf::Vertex{a, color});
+    vertices.append(sf::Vertex{c, color});
+    vertices.append(sf::Vertex{d, color});
+}
+
+// Retângulo width x height com o canto em origin, girado em torno desse canto (como sf::RectangleShape)
+void appendRect(sf::VertexArray& vertices, sf::Vector2f origin, float width, float height, float degrees, sf::Color color) {
+    const float radians = degrees * 3.14159265f / 180.f;
+    const float c = cos(radians);
+    const float s = sin(radians);
+    auto corner = [&](float x, float y) {
+        return sf::Vector2f(origin.x + x * c - y * s, origin.y + x * s + y * c);
+    };
+    appendQuad(vertices, corner(0.f, 0.f), corner(width, 0.f), corner(width, height), corner(0.f, height), color);
+}
+
+// Anel entre os raios inner e outer (o contorno de um sf::CircleShape transparente)
+void appendRing(sf::VertexArray& vertices, sf::Vector2f center, float inner, float outer, sf::Color color) {
+    for (int i = 0; i < RING_POINTS; ++i) {
+        const float a0 = 2.f * 3.14159265f * i / RING_POINTS;
+        const float a1 = 2.f * 3.14159265f * (i + 1) / RING_POINTS;
+        appendQuad(vertices,
+                   {center.x + inner * cos(a0), center.y + inner * sin(a0)},
+                   {center.x + outer * cos(a0), center.y + outer * sin(a0)},
+                   {center.x + outer * cos(a1), center.y + outer * sin(a1)},
+                   {center.x + inner * cos(a1), center.y + inner * sin(a1)},
+                   color);
     }
 }
 
-bool Board::makeMove(int row, int col, Player player) {
+}
+
+template <int Rows, int Cols, int K>
+Board<Rows, Cols, K>::Board()
+    : position(), geometry(new sf::VertexArray(sf::PrimitiveType::Triangles)), geometryReady(false) {}
+
+template <int Rows, int Cols, int K>
+Board<Rows, Cols, K>::~Board() {
+    delete geometry;
+}
+
+template <int Rows, int Cols, int K>
+void Board<Rows, Cols, K>::reset() {
+    position.reset();
+}
+
+template <int Rows, int Cols, int K>
+bool Board<Rows, Cols, K>::makeMove(int row, int col, Player player) {
     if (isValidMove(row, col)) {
-        grid[row][col] = player;
+        position.makeMove(Grid::index(row, col), player);
         return true;
     }
     return false;
 }
 
-bool Board::isValidMove(int row, int col) const {
-    return row >= 0 && row < 3 && col >= 0 && col < 3 && grid[row][col] == Player::NONE;
+template <int Rows, int Cols, int K>
+bool Board<Rows, Cols, K>::unmakeMove() {
+    if (position.getPly() == 0) return false;
+    position.unmakeMove();
+    return true;
 }
 
-Player Board::checkWinner() const {
-    // Check linhas
-    for (int i = 0; i < 3; ++i) {
-        if (grid[i][0] != Player::NONE && 
-            grid[i][0] == grid[i][1] && 
-            grid[i][1] == grid[i][2]) {
-            return grid[i][0];
-        }
-    }
-    
-    // Check colunas
-    for (int i = 0; i < 3; ++i) {
-        if (grid[0][i] != Player::NONE && 
-            grid[0][i] == grid[1][i] && 
-            grid[1][i] == grid[2][i]) {
-            return grid[0][i];
-        }
-    }
-    
-    // Check diagonais
-    if (grid[0][0] != Player::NONE && 
-        grid[0][0] == grid[1][1] && 
-        grid[1][1] == grid[2][2]) {
-        return grid[0][0];
-    }
-    if (grid[0][2] != Player::NONE && 
-        grid[0][2] == grid[1][1] && 
-        grid[1][1] == grid[2][0]) {
-        return grid[0][2];
+template <int Rows, int Cols, int K>
+bool Board<Rows, Cols, K>::isValidMove(int row, int col) const {
+    return row >= 0 && row < Rows && col >= 0 && col < Cols && position.getBoard().isEmpty(row, col);
+}
+
+// O vencedor é atualizado a cada jogada, conferindo só as linhas da casa jogada
+template <int Rows, int Cols, int K>
+Player Board<Rows, Cols, K>::checkWinner() const {
+    return position.getWinner();
+}
+
+template <int Rows, int Cols, int K>
+bool Board<Rows, Cols, K>::isBoardFull() const {
+    return position.getBoard().isFull();
+}
+
+template <int Rows, int Cols, int K>
+Player Board<Rows, Cols, K>::getCell(int row, int col) const {
+    if (row >= 0 && row < Rows && col >= 0 && col < Cols) {
+        return position.getBoard().get(row, col);
     }
-    
     return Player::NONE;
 }
 
-bool Board::isBoardFull() const {
-    for (const auto& row : grid) {
-        for (const auto& cell : row) {
-            if (cell == Player::NONE) {
-                return false;
-            }
-        }
-    }
-    return true;
+template <int Rows, int Cols, int K>
+const typename Board<Rows, Cols, K>::Grid& Board<Rows, Cols, K>::getGrid() const {
+    return position.getBoard();
 }
 
-Player Board::getCell(int row, int col) const {
-    if (row >= 0 && row < 3 && col >= 0 && col < 3) {
-        return grid[row][col];
+// Só refaz a geometria quando alguma casa mudou desde o último quadro
+template <int Rows, int Cols, int K>
+void Board<Rows, Cols, K>::draw(sf::RenderWindow& window) {
+    if (needsRedraw()) {
+        rebuildGeometry();
     }
-    return Player::NONE;
+    window.draw(*geometry);
 }
 
-const vector<vector<Player>>& Board::getGrid() const {
-    return grid;
+template <int Rows, int Cols, int K>
+bool Board<Rows, Cols, K>::needsRedraw() const {
+    return !geometryReady || !(drawnGrid == position.getBoard());
 }
 
-void Board::draw(sf::RenderWindow& window) {
-    // Tabuleiro
+/*
+ * @brief Monta grade e peças em triângulos, com as mesmas medidas das
+ * formas do SFML usadas antes (linhas, X em duas barras giradas, O em anel)
+ */
+template <int Rows, int Cols, int K>
+void Board<Rows, Cols, K>::rebuildGeometry() {
+    // Tabuleiro: a área é fixa e as casas encolhem conforme o tamanho
     const float boardSize = 300.f;
-    const float cellSize = boardSize / 3.f;
-    const float startX = (400.f - boardSize) / 2.f;
+    const float cellSize = boardSize / static_cast<float>(Rows > Cols ? Rows : Cols);
+    const float width = cellSize * Cols;
+    const float height = cellSize * Rows;
+    const float startX = (400.f - width) / 2.f;
     const float startY = 50.f;
+    const float thickness = cellSize >= 60.f ? 5.f : 2.f;
     
-    // Desenhar linhas do tabuleiro
-    sf::RectangleShape line;
-    line.setFillColor(sf::Color::White);
-    
-    line.setSize({5.f, boardSize});
-    line.setPosition({startX + cellSize, startY});
-    window.draw(line);
-    line.setPosition({startX + 2 * cellSize, startY});
-    window.draw(line);
+    geometry->clear();
     
-    line.setSize({boardSize, 5.f});
-    line.setPosition({startX, startY + cellSize});
-    window.draw(line);
-    line.setPosition({startX, startY + 2 * cellSize});
-    window.draw(line);
+    // Linhas do tabuleiro
+    for (int col = 1; col < Cols; ++col) {
+        appendRect(*geometry, {startX + col * cellSize, startY}, thickness, height, 0.f, sf::Color::White);
+    }
+    for (int row = 1; row < Rows; ++row) {
+        appendRect(*geometry, {startX, startY + row * cellSize}, width, thickness, 0.f, sf::Color::White);
+    }
     
-    // Desenhar X e O
-    for (int row = 0; row < 3; ++row) {
-        for (int col = 0; col < 3; ++col) {
+    // X e O
+    const Grid& grid = position.getBoard();
+    for (int row = 0; row < Rows; ++row) {
+        for (int col = 0; col < Cols; ++col) {
             float centerX = startX + col * cellSize + cellSize / 2.f;
             float centerY = startY + row * cellSize + cellSize / 2.f;
             float size = cellSize * 0.3f;
             
-            if (grid[row][col] == Player::X) {
-                // X usando duas linhas que se cruzam no centro
-                // Linha 1: de NO para SE
-                sf::RectangleShape line1({5.f, size * 2.8f});
-                line1.setFillColor(sf::Color::Red);
-                line1.setPosition({centerX + size * 1.0f, centerY - size*1.1f});
-                line1.setRotation(sf::degrees(45.f));
-                window.draw(line1);
-                
-                // Linha 2: de NE para SO
-                sf::RectangleShape line2({5.f, size * 2.8f});
-                line2.setFillColor(sf::Color::Red);
-                line2.setPosition({centerX - size * 0.9f, centerY - size});
-                line2.setRotation(sf::degrees(-45.f));
-                window.draw(line2);
-                
-            } else if (grid[row][col] == Player::O) {
-                // O
-                sf::CircleShape circle(size);
-                circle.setFillColor(sf::Color::Transparent);
-                circle.setOutlineColor(sf::Color::Blue);
-                circle.setOutlineThickness(5.f);
-                circle.setPosition({centerX - size, centerY - size});
-                window.draw(circle);
+            if (grid.get(row, col) == Player::X) {
+                // Duas barras que se cruzam no centro: de NO para SE e de NE para SO
+                appendRect(*geometry, {centerX + size * 1.0f, centerY - size * 1.1f}, thickness, size * 2.8f, 45.f, sf::Color::Red);
+                appendRect(*geometry, {centerX - size * 0.9f, centerY - size}, thickness, size * 2.8f, -45.f, sf::Color::Red);
+            } else if (grid.get(row, col) == Player::O) {
+                // Contorno para fora do raio, como o outline do sf::CircleShape
+                appendRing(*geometry, {centerX, centerY}, size, size + thickness, sf::Color::Blue);
             }
         }
     }
+    
+    drawnGrid = grid;
+    geometryReady = true;
 }
+
+// Tabuleiros suportados pelo jogo
+template class Board<3, 3, 3>;
+template class Board<4, 4, 4>;
+template class Board<5, 5, 4>;
+template class Board<15, 15, 5>;
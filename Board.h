@@ -1,42 +1,82 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#include <vector>
+#include "Position.h"
 using namespace std;
-    
+
 namespace sf {
     class RenderWindow;
+    class VertexArray;
 }
 
-enum class Player { NONE, X, O };
-
+/*
+ * @class BoardBase
+ * @brief Interface do tabuleiro usada pelo Game, independente do tamanho
+ */
+class BoardBase {
+public:
+    virtual ~BoardBase() {}
+    
+    virtual void reset() = 0;
+    virtual bool makeMove(int row, int col, Player player) = 0;
+    virtual bool unmakeMove() = 0; // desfaz a última jogada (false se não houver)
+    virtual bool isValidMove(int row, int col) const = 0;
+    virtual Player checkWinner() const = 0;
+    virtual bool isBoardFull() const = 0;
+    virtual Player getCell(int row, int col) const = 0;
+    virtual int getRows() const = 0;
+    virtual int getCols() const = 0;
+    virtual int getWinLength() const = 0; // peças em sequência para vencer
+    
+    virtual void draw(sf::RenderWindow& window) = 0;
+    virtual bool needsRedraw() const = 0; // alguma casa mudou desde o último draw
+};
 
 /*
  * @class Board  
- * @brief Representa o tabuleiro do jogo da velha e sua lógica
+ * @brief Representa o tabuleiro m,n,k do jogo e sua lógica
  * 
  * Responsável por:
- * - Armazenar o estado do tabuleiro 3x3
- * - Validar movimentos
- * - Verificar condições de vitória/empate
- * - Renderizar graficamente o tabuleiro
+ * - Armazenar o estado do tabuleiro Rows x Cols (Position sobre um BitBoard)
+ * - Validar movimentos, jogar e desfazer jogadas
+ * - Verificar condições de vitória (K em linha, só pelas linhas da última
+ *   jogada) e empate
+ * - Renderizar graficamente o tabuleiro: grade e peças ficam em um único
+ *   vertex array, refeito só quando alguma casa muda (uma chamada de desenho
+ *   por quadro)
  */
-class Board {
+template <int Rows, int Cols, int K>
+class Board : public BoardBase {
 public:
+    using Grid = BitBoard<Rows, Cols, K>;
+    
     Board();
+    ~Board();
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
     
-    void reset();
-    bool makeMove(int row, int col, Player player);
-    bool isValidMove(int row, int col) const;
-    Player checkWinner() const;
-    bool isBoardFull() const;
-    Player getCell(int row, int col) const;
-    const vector<vector<Player>>& getGrid() const;
+    void reset() override;
+    bool makeMove(int row, int col, Player player) override;
+    bool unmakeMove() override;
+    bool isValidMove(int row, int col) const override;
+    Player checkWinner() const override;
+    bool isBoardFull() const override;
+    Player getCell(int row, int col) const override;
+    int getRows() const override { return Rows; }
+    int getCols() const override { return Cols; }
+    int getWinLength() const override { return K; }
+    const Grid& getGrid() const;
     
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
+    bool needsRedraw() const override;
     
 private:
-    vector<vector<Player>> grid;
+    Position<Rows, Cols, K> position;
+    sf::VertexArray* geometry; // Triângulos da grade e das peças
+    Grid drawnGrid;            // Casas que geometry representa
+    bool geometryReady;        // geometry já foi montado ao menos uma vez
+    
+    void rebuildGeometry();
 };
 
 #endif
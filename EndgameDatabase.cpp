@@ -0,0 +1,148 @@
+#include "EndgameDatabase.h"
+#include <array>
+#include <cstdio>
+using namespace std;
+
+namespace {
+
+using BinomialTable = array<array<uint64_t, endgame::MAX_CELLS + 1>, endgame::MAX_CELLS + 1>;
+
+constexpr BinomialTable buildBinomials() {
+    BinomialTable table{};
+    for (int n = 0; n <= endgame::MAX_CELLS; ++n) {
+        table[n][0] = 1;
+        for (int k = 1; k <= n; ++k) table[n][k] = table[n - 1][k - 1] + (k < n ? table[n - 1][k] : 0);
+    }
+    return table;
+}
+
+constexpr BinomialTable BINOMIALS = buildBinomials();
+
+}
+
+namespace endgame {
+
+uint64_t binomial(int n, int k) {
+    return (k < 0 || k > n) ? 0 : BINOMIALS[n][k];
+}
+
+/*
+ * @brief Soma de C(b_i, i + 1) sobre os bits b_0 < b_1 < ... do subconjunto;
+ * é a mesma ordem em que o truque de Gosper enumera os subconjuntos
+ */
+uint64_t rankSubset(uint32_t mask) {
+    uint64_t rank = 0;
+    for (int i = 1; mask != 0; ++i, mask &= mask - 1) {
+        rank += BINOMIALS[__builtin_ctz(mask)][i];
+    }
+    return rank;
+}
+
+uint64_t positionIndex(uint32_t x, uint32_t o) {
+    uint32_t occupied = x | o;
+    int ply = __builtin_popcount(occupied);
+
+    // Marcas de X comprimidas para as posições das casas ocupadas
+    uint32_t xAmongOccupied = 0;
+    int j = 0;
+    for (uint32_t rest = occupied; rest != 0; rest &= rest - 1, ++j) {
+        if (x & (rest & (~rest + 1))) xAmongOccupied |= 1u << j;
+    }
+    return rankSubset(occupied) * binomial(ply, (ply + 1) / 2) + rankSubset(xAmongOccupied);
+}
+
+uint64_t layerSize(int cells, int ply) {
+    return binomial(cells, ply) * binomial(ply, (ply + 1) / 2);
+}
+
+string layerPath(const string& directory, int rows, int cols, int k, int ply) {
+    char name[32];
+    snprintf(name, sizeof(name), "%dx%dk%d_%02d.db", rows, cols, k, ply);
+    return directory + "/" + name;
+}
+
+}
+
+template <int Rows, int Cols, int K>
+bool EndgameDatabase<Rows, Cols, K>::open(const string& directory) {
+    close();
+    layers.resize(CELLS + 1);
+    for (int ply = 0; ply <= CELLS; ++ply) {
+        layers[ply].open(endgame::layerPath(directory, Rows, Cols, K, ply), ios::binary);
+        endgame::LayerHeader header{};
+        if (!layers[ply].read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != endgame::MAGIC || header.version != endgame::VERSION ||
+            header.rows != Rows || header.cols != Cols || header.k != K || header.ply != ply ||
+            header.count != endgame::layerSize(CELLS, ply)) {
+            close();
+            return false;
+        }
+    }
+    opened = true;
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+void EndgameDatabase<Rows, Cols, K>::close() {
+    layers.clear();
+    opened = false;
+}
+
+template <int Rows, int Cols, int K>
+uint8_t EndgameDatabase<Rows, Cols, K>::probe(const Board& board) {
+    if (!opened) return endgame::INVALID;
+    uint32_t x = uint32_t(board.x), o = uint32_t(board.o);
+    int ply = __builtin_popcount(x | o);
+    int countX = __builtin_popcount(x);
+    if (countX != (ply + 1) / 2) return endgame::INVALID;
+
+    ifstream& layer = layers[ply];
+    char value = 0;
+    layer.clear();
+    layer.seekg(streamoff(sizeof(endgame::LayerHeader) + endgame::positionIndex(x, o)));
+    if (!layer.read(&value, 1)) return endgame::INVALID;
+    return uint8_t(value);
+}
+
+/*
+ * @brief Mesma preferência da tabela do 3x3: vitória mais rápida, depois
+ * empate, depois a derrota mais demorada
+ */
+template <int Rows, int Cols, int K>
+typename BitBoard<Rows, Cols, K>::Mask EndgameDatabase<Rows, Cols, K>::bestMoves(const Board& board) {
+    using Mask = typename Board::Mask;
+    Mask best = 0;
+    if (!opened || board.isGameOver()) return best;
+
+    Player toMove = playerToMove(board);
+    int bestResult = -1, bestDistance = 0;
+    Mask empty = board.emptyCells();
+    while (anyBit(empty)) {
+        int cell = lowestBit(empty);
+        clearLowest(empty);
+
+        Board child = board;
+        child.set(cell / Cols, cell % Cols, toMove);
+        uint8_t value = probe(child);
+        if (endgame::resultOf(value) == endgame::INVALID) return 0;
+
+        // O resultado do filho é do ponto de vista do adversário
+        int result = endgame::WIN + endgame::LOSS - endgame::resultOf(value);
+        int distance = endgame::distanceOf(value) + 1;
+        bool better = result > bestResult ||
+            (result == bestResult && (result == endgame::WIN ? distance < bestDistance : distance > bestDistance));
+        if (better) {
+            best = 0;
+            bestResult = result;
+            bestDistance = distance;
+        }
+        if (result == bestResult && distance == bestDistance) best |= cellBit<Mask>(cell);
+    }
+    return best;
+}
+
+// Tabuleiros que cabem no banco de finais
+template class EndgameDatabase<3, 3, 3>;
+template class EndgameDatabase<4, 4, 3>;
+template class EndgameDatabase<4, 4, 4>;
+template class EndgameDatabase<5, 5, 4>;
@@ -0,0 +1,85 @@
+#ifndef ENDGAMEDATABASE_H
+#define ENDGAMEDATABASE_H
+
+#include "Bitboard.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * @brief Formato de um byte por posição nos arquivos do banco de finais
+ *
+ * Bits 6-7: resultado para quem joga (0 = posição impossível, 1 = derrota,
+ * 2 = empate, 3 = vitória); bits 0-5: jogadas até o fim com jogo perfeito.
+ */
+namespace endgame {
+
+enum Result : uint8_t { INVALID = 0, LOSS = 1, DRAW = 2, WIN = 3 };
+
+inline uint8_t encode(Result result, int distance) { return uint8_t((result << 6) | distance); }
+inline Result resultOf(uint8_t value) { return Result(value >> 6); }
+inline int distanceOf(uint8_t value) { return value & 0x3F; }
+
+constexpr uint32_t MAGIC = 0x45445643;  // "CVDE"
+constexpr uint32_t VERSION = 1;
+constexpr int MAX_CELLS = 32;           // Casas cabem em 32 bits e a distância em 6
+
+/*
+ * @struct LayerHeader
+ * @brief Cabeçalho de cada arquivo de camada (uma camada = um número de peças)
+ */
+struct LayerHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t rows, cols, k, ply;
+    uint32_t reserved;
+    uint64_t count;     // Posições na camada (bytes após o cabeçalho)
+};
+
+// Coeficientes binomiais C(n, k) para n, k <= MAX_CELLS
+uint64_t binomial(int n, int k);
+
+// Índice de um subconjunto de bits na ordem colexicográfica
+uint64_t rankSubset(uint32_t mask);
+
+// Índice da posição dentro da sua camada: casas ocupadas, depois quais são X
+uint64_t positionIndex(uint32_t x, uint32_t o);
+
+// Posições com ply peças (X joga primeiro, então X tem ceil(ply/2))
+uint64_t layerSize(int cells, int ply);
+
+string layerPath(const string& directory, int rows, int cols, int k, int ply);
+
+}
+
+/*
+ * @class EndgameDatabase
+ * @brief Leitor do banco de finais gerado pelo RetrogradeSolver
+ *
+ * Os arquivos ficam no disco e cada consulta lê um único byte, então a memória
+ * não cresce com o tamanho do banco. Não é seguro para várias threads ao mesmo
+ * tempo: cada AIPlayer tem o seu. Em tabuleiros grandes demais (SUPPORTED
+ * falso) a classe existe só para o AIPlayer compilar e nunca é aberta.
+ */
+template <int Rows, int Cols, int K>
+class EndgameDatabase {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr bool SUPPORTED = CELLS <= endgame::MAX_CELLS;
+
+    bool open(const string& directory); // todas as camadas precisam existir e bater com o tabuleiro
+    void close();
+    bool isOpen() const { return opened; }
+
+    uint8_t probe(const Board& board); // byte codificado; INVALID se não houver
+    typename Board::Mask bestMoves(const Board& board); // casas que mantêm o resultado ótimo
+
+private:
+    vector<ifstream> layers;    // Uma por número de peças, 0 a CELLS
+    bool opened = false;
+};
+
+#endif
@@ -0,0 +1,292 @@
+#include "EngineProtocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+
+namespace {
+
+bool parseDifficulty(const string& name, Difficulty& difficulty) {
+    if (name == "easy") difficulty = Difficulty::EASY;
+    else if (name == "medium") difficulty = Difficulty::MEDIUM;
+    else if (name == "hard") difficulty = Difficulty::HARD;
+    else if (name == "mcts") difficulty = Difficulty::MCTS;
+    else return false;
+    return true;
+}
+
+}
+
+EngineProtocol::EngineProtocol(istream& input, ostream& output) : input(input), output(output) {
+}
+
+EngineProtocol::~EngineProtocol() {
+    commandStop();
+}
+
+int EngineProtocol::run() {
+    string line;
+    while (getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!handle(line)) {
+            commandStop();
+            return 0;
+        }
+    }
+    // Fim da entrada sem quit: o go em andamento termina e responde o bestmove
+    waitSearch();
+    return 0;
+}
+
+bool EngineProtocol::handle(const string& line) {
+    istringstream args(line);
+    string command;
+    if (!(args >> command)) return true;
+
+    if (command == "quit") {
+        return false;
+    } else if (command == "uci") {
+        commandUci();
+    } else if (command == "isready") {
+        // Responde na hora, mesmo durante go: uma busca já tem a IA criada e em uso
+        if (!searching) ensurePlayer();
+        send("readyok");
+    } else if (command == "ucinewgame") {
+        waitSearch();
+        ensurePlayer();
+        resetPosition();
+    } else if (command == "setoption") {
+        waitSearch();
+        commandSetOption(args);
+    } else if (command == "position") {
+        waitSearch();
+        commandPosition(args);
+    } else if (command == "go") {
+        waitSearch();
+        commandGo(args);
+    } else if (command == "stop") {
+        commandStop();
+    } else {
+        send("info string comando desconhecido: " + command);
+    }
+    return true;
+}
+
+void EngineProtocol::commandUci() {
+    send("id name Jogo da Velha");
+    send("option name difficulty type combo default hard var easy var medium var hard var mcts");
+    send("option name board type combo default 3 var 3 var 4 var 5 var 15");
+    send("option name threads type spin default 0 min 0 max 256");
+    send("option name seed type spin default 0 min 0 max 4294967295");
+    send("option name endgame type string default endgame");
+    send("uciok");
+}
+
+// setoption name <nome> value <valor>
+void EngineProtocol::commandSetOption(istringstream& args) {
+    string word, name, value;
+    args >> word >> name >> word >> value;
+
+    if (name == "difficulty") {
+        if (!parseDifficulty(value, difficulty)) {
+            send("info string dificuldade inválida: " + value);
+            return;
+        }
+        if (player) player->setDifficulty(difficulty);
+    } else if (name == "board") {
+        int size = atoi(value.c_str());
+        int option = size == 4 ? 1 : size == 5 ? 2 : size == 15 ? 3 : size == 3 ? 0 : -1;
+        if (option < 0) {
+            send("info string tabuleiro inválido: " + value);
+            return;
+        }
+        if (option != boardOption) {
+            boardOption = option;
+            moves.clear();
+            player.reset(); // recriada no próximo comando que precisar
+        }
+    } else if (name == "threads") {
+        threads = atoi(value.c_str());
+        player.reset();
+    } else if (name == "seed") {
+        hasSeed = true;
+        seed = uint32_t(strtoul(value.c_str(), nullptr, 10));
+        if (player) player->setSeed(seed);
+    } else if (name == "endgame") {
+        endgameDirectory = value;
+        player.reset();
+    } else {
+        send("info string opção desconhecida: " + name);
+    }
+}
+
+/*
+ * @brief Cria a IA do tabuleiro escolhido, guarda seus orçamentos padrão e
+ * reaplica as jogadas da partida atual; nunca troca uma IA existente (só
+ * setoption a descarta, depois de esperar a busca)
+ */
+void EngineProtocol::ensurePlayer() {
+    if (player) return;
+
+    switch (boardOption) {
+        case 1: player = make_unique<AIPlayer<4, 4, 4>>(Player::O, difficulty); rows = cols = 4; break;
+        case 2: player = make_unique<AIPlayer<5, 5, 4>>(Player::O, difficulty); rows = cols = 5; break;
+        case 3: player = make_unique<AIPlayer<15, 15, 5>>(Player::O, difficulty); rows = cols = 15; break;
+        default: player = make_unique<AIPlayer<3, 3, 3>>(Player::O, difficulty); rows = cols = 3; break;
+    }
+    player->setVerbose(false);
+    if (hasSeed) player->setSeed(seed);
+    if (!player->loadPositionBook(endgameDirectory)) {
+        player->loadEndgameDatabase(endgameDirectory);
+    }
+
+    defaultLimits = player->getSearchLimits();
+    defaultMCTSLimits = player->getMCTSLimits();
+    if (threads > 0) {
+        defaultLimits.threads = threads;
+        defaultMCTSLimits.threads = threads;
+    }
+
+    vector<pair<int, int>> replay;
+    replay.swap(moves);
+    resetPosition();
+    for (const auto& move : replay) {
+        if (!applyMove(move)) break;
+    }
+}
+
+void EngineProtocol::resetPosition() {
+    player->resetTree();
+    moves.clear();
+    occupied.assign(size_t(rows * cols), 0);
+}
+
+bool EngineProtocol::applyMove(const pair<int, int>& move) {
+    if (move.first < 0 || move.first >= rows || move.second < 0 || move.second >= cols ||
+        occupied[size_t(move.first * cols + move.second)] || player->isFinished()) {
+        return false;
+    }
+    player->updateTree(move);
+    occupied[size_t(move.first * cols + move.second)] = 1;
+    moves.push_back(move);
+    return true;
+}
+
+// position startpos [moves m1 m2 ...]
+void EngineProtocol::commandPosition(istringstream& args) {
+    ensurePlayer();
+    string word;
+    args >> word;
+    if (word != "startpos") {
+        send("info string só startpos é suportado");
+        return;
+    }
+
+    vector<pair<int, int>> received;
+    if (args >> word && word == "moves") {
+        while (args >> word) {
+            pair<int, int> move;
+            if (!parseMove(word, move)) {
+                send("info string jogada inválida: " + word);
+                return;
+            }
+            received.push_back(move);
+        }
+    }
+
+    // Continuação da partida atual: só as jogadas novas (a árvore Monte Carlo é mantida)
+    bool continues = received.size() >= moves.size() && equal(moves.begin(), moves.end(), received.begin());
+    if (!continues) resetPosition();
+    for (size_t i = moves.size(); i < received.size(); ++i) {
+        if (!applyMove(received[i])) {
+            send("info string jogada inválida: " + formatMove(received[i]));
+            return;
+        }
+    }
+}
+
+// go [nodes N] [movetime MS]
+void EngineProtocol::commandGo(istringstream& args) {
+    ensurePlayer();
+    SearchLimits limits = defaultLimits;
+    MCTSLimits mctsLimits = defaultMCTSLimits;
+    string word;
+    while (args >> word) {
+        long long value = 0;
+        if (!(args >> value)) break;
+        if (word == "nodes") {
+            limits.maxNodes = uint64_t(value);
+            limits.timeBudget = chrono::microseconds(0);
+            mctsLimits.playouts = uint32_t(value);
+            mctsLimits.timeBudget = chrono::microseconds(0);
+        } else if (word == "movetime") {
+            limits.timeBudget = chrono::milliseconds(value);
+            mctsLimits.timeBudget = chrono::milliseconds(value);
+            mctsLimits.playouts = 0xFFFFFFFFu; // só o prazo limita
+        }
+    }
+
+    if (player->isFinished()) {
+        send("bestmove (none)");
+        return;
+    }
+    player->setSearchLimits(limits);
+    player->setMCTSLimits(mctsLimits);
+    player->setSide(moves.size() % 2 == 0 ? Player::X : Player::O);
+
+    searching = true;
+    player->prepareSearch(); // antes do disparo: um stop logo depois já vale
+    searchThread = thread([this]() {
+        auto start = chrono::steady_clock::now();
+        pair<int, int> move = player->getBestMove();
+        long long millis = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+        // Estatísticas só quando um motor rodou nesta jogada: livro, tabela e
+        // banco de finais respondem sem buscar e os contadores são da busca anterior
+        ostringstream info;
+        info << "info time " << millis;
+        MovePath path = player->getLastPath();
+        if (path == MovePath::SEARCH) {
+            const SearchStats& stats = player->getSearchStats();
+            info << " depth " << stats.depthReached << " nodes " << stats.nodes << " score " << stats.bestScore;
+        } else if (path == MovePath::MCTS) {
+            const MCTSStats& stats = player->getMCTSStats();
+            info << " playouts " << stats.playouts << " nodes " << stats.nodes;
+        }
+        info << " string " << movePathName(path);
+        send(info.str());
+        send(move.first < 0 ? string("bestmove (none)") : "bestmove " + formatMove(move));
+        searching = false;
+    });
+}
+
+/*
+ * @brief Pede parada e espera a busca responder; o pedido vale até o próximo
+ * go, mesmo que a busca ainda não tenha começado
+ */
+void EngineProtocol::commandStop() {
+    if (searching && player) player->stopSearch();
+    waitSearch();
+}
+
+void EngineProtocol::waitSearch() {
+    if (searchThread.joinable()) searchThread.join();
+}
+
+void EngineProtocol::send(const string& line) {
+    lock_guard<mutex> guard(outputLock);
+    output << line << endl;
+}
+
+string EngineProtocol::formatMove(const pair<int, int>& move) const {
+    return string(1, char('a' + move.second)) + to_string(move.first + 1);
+}
+
+bool EngineProtocol::parseMove(const string& text, pair<int, int>& move) const {
+    if (text.size() < 2 || text[0] < 'a' || text[0] > 'z') return false;
+    for (size_t i = 1; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+    }
+    move = { atoi(text.c_str() + 1) - 1, text[0] - 'a' };
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef ENGINEPROTOCOL_H
+#define ENGINEPROTOCOL_H
+
+#include "AIPlayer.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/*
+ * @class EngineProtocol
+ * @brief Modo texto no estilo UCI: comandos por linha na entrada, respostas na saída
+ *
+ * Comandos:
+ * - uci, isready, ucinewgame, quit
+ * - setoption name difficulty|board|threads|seed|endgame value V
+ * - position startpos [moves a1 b2 ...] (coluna em letra, linha de cima = 1)
+ * - go [nodes N] [movetime MS]: responde "info ..." (com "string" e a origem
+ *   da jogada: search, solved_table, book...) e "bestmove c3"
+ * - stop: interrompe a busca em andamento, que responde na hora
+ *
+ * A IA é criada só no primeiro comando que precisa dela (isready, position ou
+ * go), então o processo responde a "uci" sem construir nada, e fica residente
+ * entre as partidas: position que continua a partida anterior só aplica as
+ * jogadas novas, mantendo a árvore Monte Carlo. A busca roda em uma thread
+ * própria para "stop" poder chegar enquanto ela trabalha.
+ */
+class EngineProtocol {
+public:
+    EngineProtocol(istream& input, ostream& output);
+    ~EngineProtocol();
+
+    int run(); // lê comandos até "quit" ou o fim da entrada
+
+private:
+    istream& input;
+    ostream& output;
+    mutex outputLock;           // A thread da busca e a de comandos escrevem na mesma saída
+
+    unique_ptr<AIPlayerBase> player;
+    int boardOption = 0;        // 0 = 3x3, 1 = 4x4 (K4), 2 = 5x5 (K4), 3 = 15x15 (K5)
+    int rows = 3, cols = 3;
+    Difficulty difficulty = Difficulty::HARD;
+    int threads = 0;            // 0 = padrão da IA
+    bool hasSeed = false;
+    uint32_t seed = 0;
+    string endgameDirectory = "endgame";
+    SearchLimits defaultLimits; // Orçamentos da IA recém-criada, restaurados a cada go
+    MCTSLimits defaultMCTSLimits;
+
+    vector<pair<int, int>> moves; // Jogadas já aplicadas na IA
+    vector<uint8_t> occupied;     // Casas ocupadas, para validar as jogadas recebidas
+
+    thread searchThread;
+    atomic<bool> searching{false};
+
+    bool handle(const string& line); // false em "quit"
+    void commandUci();
+    void commandSetOption(istringstream& args);
+    void commandPosition(istringstream& args);
+    void commandGo(istringstream& args);
+    void commandStop();
+
+    void ensurePlayer();
+    void resetPosition();
+    bool applyMove(const pair<int, int>& move);
+    void waitSearch();
+    void send(const string& line);
+
+    string formatMove(const pair<int, int>& move) const;
+    bool parseMove(const string& text, pair<int, int>& move) const;
+};
+
+#endif
@@ -1,62 +1,192 @@
 #include "Game.h"
+#include "Logger.h"
 #include <SFML/Graphics.hpp>
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 using namespace std;
 
+// Tabuleiros disponíveis (tecla B): linhas, colunas e peças em sequência para vencer
+namespace {
+struct BoardOption {
+    int rows;
+    int cols;
+    int winLength;
+};
+
+const BoardOption BOARD_OPTIONS[] = {
+    {3, 3, 3},
+    {4, 4, 4},
+    {5, 5, 4},
+    {15, 15, 5},
+};
+
+const int NUM_BOARD_OPTIONS = sizeof(BOARD_OPTIONS) / sizeof(BOARD_OPTIONS[0]);
+
+string describeBoard(int option) {
+    const BoardOption& b = BOARD_OPTIONS[option];
+    return to_string(b.rows) + "x" + to_string(b.cols) + " (" + to_string(b.winLength) + " em linha)";
+}
+
+// Cria a IA do tabuleiro escolhido; roda fora da thread da janela
+AIPlayerBase* createAIPlayer(int option, Difficulty difficulty) {
+    AIPlayerBase* aiPlayer;
+    switch (option) {
+        case 1: aiPlayer = new AIPlayer<4, 4, 4>(Player::O, difficulty); break;
+        case 2: aiPlayer = new AIPlayer<5, 5, 4>(Player::O, difficulty); break;
+        case 3: aiPlayer = new AIPlayer<15, 15, 5>(Player::O, difficulty); break;
+        default: aiPlayer = new AIPlayer<3, 3, 3>(Player::O, difficulty); break;
+    }
+    
+    // Gerados por "solve"; sem eles a Difícil continua com o motor de busca
+    if (!aiPlayer->loadPositionBook("endgame")) {
+        aiPlayer->loadEndgameDatabase("endgame");
+    }
+    return aiPlayer;
+}
+
+bool isReady(const future<AIPlayerBase*>& task) {
+    return task.wait_for(chrono::seconds(0)) == future_status::ready;
+}
+
+// Texto do painel: última decisão, memória e latência por dificuldade
+string describeTelemetry(const Telemetry& telemetry) {
+    ostringstream text;
+    text << fixed << setprecision(1);
+    if (telemetry.decisions() == 0) {
+        text << "IA: nenhuma jogada ainda";
+        return text.str();
+    }
+    
+    const MoveRecord& last = telemetry.last();
+    text << "Ultima: " << movePathName(last.path) << " " << last.latencyMicros / 1000.0 << " ms, "
+         << last.nodesVisited << " nos";
+    if (last.ttProbes > 0) text << ", TT " << 100.0 * last.ttHits / last.ttProbes << "%";
+    text << "\nMemoria: " << last.treeNodes << " nos, " << last.bytesHeld / 1048576.0 << " MB";
+    
+    for (int difficulty = 0; difficulty < Telemetry::DIFFICULTIES; ++difficulty) {
+        const Telemetry::Summary& summary = telemetry.summary(difficulty);
+        if (summary.decisions == 0) continue;
+        text << "\n" << difficultyName(difficulty) << ": " << summary.decisions << " jogadas, p50 "
+             << summary.latency.percentile(0.5) / 1000.0 << " ms, p99 "
+             << summary.latency.percentile(0.99) / 1000.0 << " ms, ponder "
+             << 100.0 * summary.ponderHits / summary.decisions << "%";
+    }
+    return text.str();
+}
+}
+
 // Construtor do jogo: inicializa janela, IA, jogador inicial e fonte
 Game::Game() 
     : window(nullptr)
+    , board(nullptr)
     , aiPlayer(nullptr)
+    , boardOption(0)                    // 3x3 clássico
     , currentPlayer(Player::X)          // Jogador humano começa
     , gameOver(false)
     , font(nullptr)
+    , statusText(nullptr)
+    , difficultyText(nullptr)
+    , boardText(nullptr)
+    , buttonText(nullptr)
+    , button(nullptr)
+    , showTelemetry(false)
+    , telemetryText(nullptr)
+    , telemetryPanel(nullptr)
+    , exportedDecisions(0)
+    , needsRender(true)
     , currentDifficulty(Difficulty::MEDIUM) {  // Dificuldade padrão
     
     // Cria janela SFML
     window = new sf::RenderWindow(sf::VideoMode({400, 500}), "Jogo da Velha - SFML (Árvore Persistente)");
     window->setFramerateLimit(60);
     
-    // Cria IA controlando o jogador O
-    aiPlayer = new AIPlayer(Player::O, currentDifficulty);
+    // Cria tabuleiro e IA controlando o jogador O (a IA fica pronta em segundo plano)
+    createBoard();
     
     // Carrega fonte
     font = new sf::Font();
     if (!font->openFromFile("arial.ttf")) {
-        cout << "Warning: Could not load font." << endl;
+        LOG_WARN("Could not load font.");
         delete font;
         font = nullptr;
     }
+    createHud();
 }
 
 // Destrutor: libera memória
 Game::~Game() {
+    cancelAITurn();
+    releaseAI();
     delete window;
-    delete aiPlayer;
+    delete board;
+    delete statusText;
+    delete difficultyText;
+    delete boardText;
+    delete buttonText;
+    delete button;
+    delete telemetryText;
+    delete telemetryPanel;
     if (font) delete font;
 }
 
 // Loop principal do jogo
 void Game::run() {
-    cout << "=== JOGO DA VELHA ===" << endl;
-    cout << "Dificuldade: " << 
-        (currentDifficulty == Difficulty::EASY ? "FACIL" : 
-         currentDifficulty == Difficulty::MEDIUM ? "MEDIO" : "DIFICIL") << endl;
-    cout << "Controles:" << endl;
-    cout << "- Clique no tabuleiro para jogar" << endl;
-    cout << "- Tecla D: Mudar dificuldade" << endl;
-    cout << "- Tecla R: Reiniciar jogo" << endl;
-    
-    // Loop enquanto a janela está aberta
+    LOG_INFO("=== JOGO DA VELHA ===");
+    LOG_INFO("Dificuldade: {}",
+             currentDifficulty == Difficulty::EASY ? "FACIL" :
+             currentDifficulty == Difficulty::MEDIUM ? "MEDIO" :
+             currentDifficulty == Difficulty::HARD ? "DIFICIL" : "MCTS");
+    LOG_INFO("Controles:");
+    LOG_INFO("- Clique no tabuleiro para jogar");
+    LOG_INFO("- Tecla D: Mudar dificuldade");
+    LOG_INFO("- Tecla B: Mudar tamanho do tabuleiro");
+    LOG_INFO("- Tecla R: Reiniciar jogo");
+    LOG_INFO("- Tecla T: Painel de telemetria da IA");
+    LOG_INFO("- Tecla J: Exportar telemetria (telemetry.jsonl)");
+    
+    // Loop enquanto a janela está aberta; parado, ele dorme em processEvents
+    auto started = chrono::steady_clock::now();
     while (window->isOpen()) {
-        processEvents();   // Lida com eventos do teclado e mouse
         update();          // Atualiza lógica (movimento da IA)
-        render();          // Desenha tudo na tela
+        if (needsRender || board->needsRedraw()) {
+            render();      // Desenha só se algo mudou
+        }
+        processEvents();   // Espera eventos do teclado e mouse
     }
+    printLoopStats(chrono::duration<double>(chrono::steady_clock::now() - started).count());
 }
 
-// Processa eventos do usuário
+bool Game::waitingOnAI() const {
+    return aiLoading.valid() || (currentPlayer == Player::O && !gameOver);
+}
+
+// Mostra os contadores do laço: com a janela parada, quase todo o tempo é ocioso
+void Game::printLoopStats(double seconds) const {
+    double idle = loopStats.idleMicros / 1e6;
+    double average = loopStats.frames ? loopStats.frameMicros / 1000.0 / loopStats.frames : 0.0;
+    LOG_INFO("Laço: {} despertares, {} quadros (média {} ms, pior {} ms), ocioso {} s de {} s ({}%)",
+             loopStats.wakeups, loopStats.frames, average, loopStats.maxFrameMicros / 1000.0,
+             idle, seconds, seconds > 0 ? 100.0 * idle / seconds : 0.0);
+}
+
+/*
+ * @brief Processa eventos do usuário
+ *
+ * Sem nada pendente dorme em waitEvent até o próximo evento; com a IA
+ * pensando (ou sendo montada) acorda a cada 10 ms para buscar o resultado.
+ */
 void Game::processEvents() {
-    for (auto event = window->pollEvent(); event.has_value(); event = window->pollEvent()) {
+    auto idleStart = chrono::steady_clock::now();
+    auto event = waitingOnAI() ? window->waitEvent(sf::milliseconds(10)) : window->waitEvent();
+    loopStats.idleMicros += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - idleStart).count();
+    ++loopStats.wakeups;
+    
+    for (; event.has_value(); event = window->pollEvent()) {
+        needsRender = true;  // Redimensionar, foco, teclas e cliques podem mudar a tela
+        
         if (event->is<sf::Event::Closed>()) {
             window->close();   // Fecha janela
         }
@@ -69,6 +199,15 @@ void Game::processEvents() {
             if (keyEvent->scancode == sf::Keyboard::Scan::D) {
                 cycleDifficulty();  // Alterna dificuldade
             }
+            if (keyEvent->scancode == sf::Keyboard::Scan::B) {
+                cycleBoard();  // Alterna tamanho do tabuleiro
+            }
+            if (keyEvent->scancode == sf::Keyboard::Scan::T) {
+                showTelemetry = !showTelemetry;  // Mostra/esconde o painel
+            }
+            if (keyEvent->scancode == sf::Keyboard::Scan::J) {
+                exportTelemetry();
+            }
         }
         
         // Clique do mouse
@@ -86,7 +225,7 @@ void Game::processEvents() {
     }
 }
 
-// Alterna entre fácil → médio → difícil → fácil
+// Alterna entre fácil → médio → difícil → MCTS → fácil
 void Game::cycleDifficulty() {
     switch(currentDifficulty) {
         case Difficulty::EASY:
@@ -96,37 +235,155 @@ void Game::cycleDifficulty() {
             currentDifficulty = Difficulty::HARD;
             break;
         case Difficulty::HARD:
+            currentDifficulty = Difficulty::MCTS;
+            break;
+        case Difficulty::MCTS:
             currentDifficulty = Difficulty::EASY;
             break;
     }
     
-    aiPlayer->setDifficulty(currentDifficulty);  // Atualiza IA
+    // A busca em andamento é descartada; a IA recebe a nova dificuldade na próxima vez dela
+    cancelAITurn();
+    pendingUpdate.difficultyChanged = true;
+    
+    LOG_INFO("Dificuldade alterada para: {}",
+             currentDifficulty == Difficulty::EASY ? "FACIL" :
+             currentDifficulty == Difficulty::MEDIUM ? "MEDIO" :
+             currentDifficulty == Difficulty::HARD ? "DIFICIL" : "MCTS");
+}
+
+// Cria tabuleiro e IA especializados para o tamanho escolhido
+void Game::createBoard() {
+    cancelAITurn();
+    releaseAI();
+    delete board;
+    
+    switch (boardOption) {
+        case 1: board = new Board<4, 4, 4>(); break;
+        case 2: board = new Board<5, 5, 4>(); break;
+        case 3: board = new Board<15, 15, 5>(); break;
+        default: board = new Board<3, 3, 3>(); break;
+    }
+    
+    // A IA (árvore compartilhada, tabelas, livro) é montada em segundo plano;
+    // o jogador humano já pode jogar e suas jogadas ficam em pendingUpdate
+    pendingUpdate = AIUpdate();
+    telemetrySnapshot = Telemetry();
+    exportedDecisions = 0;  // IA nova numera as decisões desde 1
+    aiLoading = async(launch::async, createAIPlayer, boardOption, currentDifficulty);
+}
+
+// Espera a construção em andamento, se houver, e libera a IA
+void Game::releaseAI() {
+    if (aiLoading.valid()) {
+        delete aiLoading.get();
+    }
+    delete aiPlayer;
+    aiPlayer = nullptr;
+}
+
+/*
+ * @brief Dispara a vez da IA em outra thread: primeiro repassa as mudanças
+ * acumuladas (reinício, dificuldade, jogadas), depois busca a jogada
+ */
+void Game::startAITurn() {
+    AIPlayerBase* ai = aiPlayer;
+    Difficulty difficulty = currentDifficulty;
+    AIUpdate changes = std::move(pendingUpdate);
+    pendingUpdate = AIUpdate();
+    
+    ai->prepareSearch();  // antes do disparo: um cancelAITurn logo depois já vale
+    aiMove = async(launch::async, [ai, difficulty, changes = std::move(changes)]() {
+        applyUpdate(ai, difficulty, changes);
+        return ai->getBestMove();  // instantânea se ponder já calculou a resposta
+    });
+}
+
+/*
+ * @brief Durante a vez do humano a IA busca a resposta a cada jogada possível
+ * dele; o clique interrompe o ponder antes de a jogada ser repassada
+ */
+void Game::startPondering() {
+    AIPlayerBase* ai = aiPlayer;
+    Difficulty difficulty = currentDifficulty;
+    AIUpdate changes = std::move(pendingUpdate);
+    pendingUpdate = AIUpdate();
+    
+    ai->prepareSearch();
+    aiPonder = async(launch::async, [ai, difficulty, changes = std::move(changes)]() {
+        applyUpdate(ai, difficulty, changes);
+        ai->ponder();
+    });
+}
+
+// Repassa à IA as mudanças acumuladas; roda na thread da IA
+void Game::applyUpdate(AIPlayerBase* ai, Difficulty difficulty, const AIUpdate& changes) {
+    if (changes.reset) ai->resetTree();
+    if (changes.difficultyChanged) ai->setDifficulty(difficulty);
+    for (const auto& move : changes.moves) {
+        ai->updateTree(move);
+    }
+}
+
+/*
+ * @brief Pede parada e espera a tarefa terminar; o pedido vale até o próximo
+ * prepareSearch, mesmo que a busca ainda não tenha começado
+ */
+void Game::cancelAITurn() {
+    if (aiMove.valid() || aiPonder.valid()) aiPlayer->stopSearch();
+    if (aiMove.valid()) aiMove.get();
+    if (aiPonder.valid()) aiPonder.get();
+}
+
+// Alterna 3x3 → 4x4 → 5x5 → 15x15 → 3x3 e começa nova partida
+void Game::cycleBoard() {
+    boardOption = (boardOption + 1) % NUM_BOARD_OPTIONS;
+    createBoard();
+    currentPlayer = Player::X;
+    gameOver = false;
     
-    cout << "Dificuldade alterada para: " << 
-        (currentDifficulty == Difficulty::EASY ? "FACIL" : 
-         currentDifficulty == Difficulty::MEDIUM ? "MEDIO" : "DIFICIL") << endl;
+    LOG_INFO("Tabuleiro alterado para: {}", describeBoard(boardOption));
 }
 
-// Atualiza lógica do jogo: turno da IA
+// Atualiza lógica do jogo: turno da IA, sem nunca esperar pela busca
 void Game::update() {
-    if (currentPlayer == Player::O && !gameOver) {
-        auto move = aiPlayer->getBestMove();  // IA escolhe movimento
+    // IA montada em segundo plano: passa a ser usada quando fica pronta
+    if (!aiPlayer && aiLoading.valid() && isReady(aiLoading)) {
+        aiPlayer = aiLoading.get();
+    }
+    
+    // Vez do humano: a IA pensa nas respostas uma vez por vez dele
+    if (currentPlayer == Player::X && !gameOver && aiPlayer && !aiPonder.valid()) {
+        startPondering();
+    }
+    
+    if (currentPlayer == Player::O && !gameOver && aiPlayer) {
+        if (!aiMove.valid()) {
+            startAITurn();
+            return;
+        }
+        if (aiMove.wait_for(chrono::seconds(0)) != future_status::ready) {
+            return;  // IA ainda pensando: o quadro é desenhado normalmente
+        }
+        auto move = aiMove.get();  // IA escolheu movimento
+        telemetrySnapshot = aiPlayer->getTelemetry();
+        needsRender = true;
         
-        if (move.first != -1 && board.isValidMove(move.first, move.second)) {
-            cout << "AI plays at: " << move.first << ", " << move.second << endl;
-            board.makeMove(move.first, move.second, currentPlayer);
+        if (move.first != -1 && board->isValidMove(move.first, move.second)) {
+            LOG_INFO("AI plays at: {}, {}", move.first, move.second);
+            board->makeMove(move.first, move.second, currentPlayer);
             
-            // IA atualiza árvore persistente
-            aiPlayer->updateTree(move);
+            // IA atualiza árvore persistente no começo da próxima vez dela
+            pendingUpdate.moves.push_back(move);
             
             // Verifica ganhador ou empate
-            Player winner = board.checkWinner();
+            Player winner = board->checkWinner();
             if (winner != Player::NONE) {
                 gameOver = true;
-                cout << "Game Over! " << (winner == Player::X ? "X" : "O") << " wins!" << endl;
-            } else if (board.isBoardFull()) {
+                LOG_INFO("Game Over! {} wins!", winner == Player::X ? "X" : "O");
+            } else if (board->isBoardFull()) {
                 gameOver = true;
-                cout << "Game Over! It's a draw!" << endl;
+                LOG_INFO("Game Over! It's a draw!");
             } else {
                 switchPlayer();  // Volta para o jogador humano
             }
@@ -136,102 +393,170 @@ void Game::update() {
 
 // Desenha tela completa
 void Game::render() {
+    auto start = chrono::steady_clock::now();
     window->clear(sf::Color::Black);
-    board.draw(*window);       // Desenha tabuleiro
+    board->draw(*window);       // Desenha tabuleiro
     displayGameStatus();       // Texto de status
     displayDifficulty();       // Texto da dificuldade
+    displayTelemetry();        // Painel da IA (tecla T)
     window->display();
+    needsRender = false;
+    
+    int64_t micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    ++loopStats.frames;
+    loopStats.frameMicros += micros;
+    loopStats.maxFrameMicros = max(loopStats.maxFrameMicros, micros);
 }
 
 // Trata clique do jogador humano
 void Game::handlePlayerClick(float x, float y) {
     if (currentPlayer != Player::X || gameOver) return;
     
-    // Dimensões do tabuleiro
+    // Dimensões do tabuleiro (mesmas de Board::draw)
+    const int rows = board->getRows();
+    const int cols = board->getCols();
     const float boardSize = 300.f;
-    const float cellSize = boardSize / 3.f;
-    const float startX = (400.f - boardSize) / 2.f;
+    const float cellSize = boardSize / static_cast<float>(rows > cols ? rows : cols);
+    const float width = cellSize * cols;
+    const float height = cellSize * rows;
+    const float startX = (400.f - width) / 2.f;
     const float startY = 50.f;
     
     // Verifica se clique ocorreu dentro do tabuleiro
-    if (x >= startX && x < startX + boardSize && y >= startY && y < startY + boardSize) {
+    if (x >= startX && x < startX + width && y >= startY && y < startY + height) {
         int col = static_cast<int>((x - startX) / cellSize);
         int row = static_cast<int>((y - startY) / cellSize);
         
-        if (board.isValidMove(row, col)) {
-            cout << "Player X moved to: " << row << ", " << col << endl;
-            board.makeMove(row, col, currentPlayer);
+        if (board->isValidMove(row, col)) {
+            cancelAITurn();  // encerra o ponder; a resposta a esta jogada já pode estar pronta
+            LOG_INFO("Player X moved to: {}, {}", row, col);
+            board->makeMove(row, col, currentPlayer);
             
-            // Atualiza árvore persistente
-            aiPlayer->updateTree({row, col});
+            // Repassada à árvore persistente quando a IA for jogar
+            pendingUpdate.moves.push_back({row, col});
             
             // Checa fim de jogo
-            Player winner = board.checkWinner();
+            Player winner = board->checkWinner();
             if (winner != Player::NONE) {
                 gameOver = true;
-            } else if (board.isBoardFull()) {
+            } else if (board->isBoardFull()) {
                 gameOver = true;
             } else {
                 switchPlayer();  // Passa turno para IA
-                cout << "AI's turn..." << endl;
+                LOG_INFO("AI's turn...");
             }
         }
     }
 }
 
+// Cria o HUD com as posições, cores e tamanhos fixos; só os textos mudam depois
+void Game::createHud() {
+    if (!font) return;
+    
+    difficultyText = new sf::Text(*font, "", 16);
+    difficultyText->setFillColor(sf::Color::Yellow);
+    difficultyText->setPosition({10.f, 10.f});
+    
+    boardText = new sf::Text(*font, "", 16);
+    boardText->setFillColor(sf::Color::Yellow);
+    boardText->setPosition({10.f, 28.f});
+    
+    statusText = new sf::Text(*font, "", 24);
+    statusText->setFillColor(sf::Color::White);
+    statusText->setPosition({120.f, 370.f});
+    
+    button = new sf::RectangleShape({200.f, 40.f});
+    button->setFillColor(sf::Color::Green);
+    button->setPosition({100.f, 400.f});
+    
+    buttonText = new sf::Text(*font, "Nova Partida", 20);
+    buttonText->setFillColor(sf::Color::Black);
+    buttonText->setPosition({130.f, 405.f});
+    
+    telemetryPanel = new sf::RectangleShape({380.f, 96.f});
+    telemetryPanel->setFillColor(sf::Color(0, 0, 0, 200));
+    telemetryPanel->setPosition({10.f, 50.f});
+    
+    telemetryText = new sf::Text(*font, "", 12);
+    telemetryText->setFillColor(sf::Color::Cyan);
+    telemetryText->setPosition({16.f, 54.f});
+}
+
+// Troca o texto só quando o conteúdo muda (evita refazer o layout dos glifos a cada quadro)
+void Game::setText(sf::Text* text, string& current, const string& value) {
+    if (current == value) return;
+    current = value;
+    text->setString(value);
+}
+
 // Mostra dificuldade atual
 void Game::displayDifficulty() {
     if (!font) return;
     
-    sf::Text diffText(*font, "", 16);
-    diffText.setFillColor(sf::Color::Yellow);
-    diffText.setPosition({10.f, 10.f});
-    
     string diffStr;
     switch(currentDifficulty) {
         case Difficulty::EASY: diffStr = "Dificuldade: FACIL (Tecla D)"; break;
         case Difficulty::MEDIUM: diffStr = "Dificuldade: MEDIO (Tecla D)"; break;
         case Difficulty::HARD: diffStr = "Dificuldade: DIFICIL (Tecla D)"; break;
+        case Difficulty::MCTS: diffStr = "Dificuldade: MCTS (Tecla D)"; break;
     }
     
-    diffText.setString(diffStr);
-    window->draw(diffText);
+    setText(difficultyText, difficultyString, diffStr);
+    window->draw(*difficultyText);
+    
+    setText(boardText, boardString, "Tabuleiro: " + describeBoard(boardOption) + " (Tecla B)");
+    window->draw(*boardText);
 }
 
 // Mostra status: vez do jogador, vitória, empate, etc
 void Game::displayGameStatus() {
     if (!font) return;
     
-    sf::Text statusText(*font, "", 24);
-    statusText.setFillColor(sf::Color::White);
-    statusText.setPosition({120.f, 370.f});
-    
     if (gameOver) {
-        Player winner = board.checkWinner();
+        Player winner = board->checkWinner();
         
         // Define texto principal
         if (winner != Player::NONE) {
-            statusText.setString((winner == Player::X) ? "X Venceu!" : "IA Venceu!");
+            setText(statusText, statusString, (winner == Player::X) ? "X Venceu!" : "IA Venceu!");
         } else {
-            statusText.setString("Empate!");
+            setText(statusText, statusString, "Empate!");
         }
         
         // Desenha botão de nova partida
-        sf::RectangleShape button({200.f, 40.f});
-        button.setFillColor(sf::Color::Green);
-        button.setPosition({100.f, 400.f});
-        window->draw(button);
-        
-        sf::Text buttonText(*font, "Nova Partida", 20);
-        buttonText.setFillColor(sf::Color::Black);
-        buttonText.setPosition({130.f, 405.f});
-        window->draw(buttonText);
+        window->draw(*button);
+        window->draw(*buttonText);
         
     } else {
-        statusText.setString((currentPlayer == Player::X) ? "Sua vez (X)" : "Vez da IA (O)");
+        setText(statusText, statusString, (currentPlayer == Player::X) ? "Sua vez (X)" : "Vez da IA (O)");
     }
     
-    window->draw(statusText);
+    window->draw(*statusText);
+}
+
+// Mostra o painel de telemetria sobre o tabuleiro
+void Game::displayTelemetry() {
+    if (!font || !showTelemetry) return;
+    
+    setText(telemetryText, telemetryString, describeTelemetry(telemetrySnapshot));
+    window->draw(*telemetryPanel);
+    window->draw(*telemetryText);
+}
+
+// Acrescenta em telemetry.jsonl só as decisões ainda não exportadas e o resumo atual
+void Game::exportTelemetry() {
+    uint64_t decisions = telemetrySnapshot.decisions();
+    if (decisions == exportedDecisions) {
+        LOG_INFO("Telemetria: nenhuma decisão nova desde a última exportação");
+        return;
+    }
+    ofstream out("telemetry.jsonl", ios::app);
+    if (!out) {
+        LOG_ERROR("não foi possível gravar telemetry.jsonl");
+        return;
+    }
+    telemetrySnapshot.writeJson(out, exportedDecisions);
+    LOG_INFO("Telemetria exportada: {} decisões novas em telemetry.jsonl", decisions - exportedDecisions);
+    exportedDecisions = decisions;
 }
 
 // Alterna jogador X <-> O
@@ -241,15 +566,18 @@ void Game::switchPlayer() {
 
 // Reinicia toalmente o jogo
 void Game::resetGame() {
-    board.reset();
+    cancelAITurn();
+    board->reset();
     currentPlayer = Player::X;
     gameOver = false;
     
-    // Reset da árvore persistente
-    aiPlayer->resetTree();
+    // Reset da árvore persistente, feito pela thread da IA antes da próxima busca
+    pendingUpdate.reset = true;
+    pendingUpdate.moves.clear();
     
-    cout << "=== NOVA PARTIDA ===" << endl;
-    cout << "Dificuldade: " << 
-        (currentDifficulty == Difficulty::
-
-
+    LOG_INFO("=== NOVA PARTIDA ===");
+    LOG_INFO("Dificuldade: {}",
+             currentDifficulty == Difficulty::EASY ? "FACIL" :
+             currentDifficulty == Difficulty::MEDIUM ? "MEDIO" :
+             currentDifficulty == Difficulty::HARD ? "DIFICIL" : "MCTS");
+}
@@ -11,6 +11,9 @@ namespace sf {
 
 #include "Board.h" //codigo do tabuleiro do jogo.
 #include "AIPlayer.h" //codigo do computador
+#include <future>
+#include <utility>
+#include <vector>
 
 class Game {
 public:
@@ -20,14 +23,55 @@ public:
     
 private:
     sf::RenderWindow* window;
-    Board board; // objeto do tabuleiro
-    AIPlayer* aiPlayer; // ponteiro para o jogador ia
+    BoardBase* board; // tabuleiro da partida (tamanho escolhido pela tecla B)
+    AIPlayerBase* aiPlayer; // ponteiro para o jogador ia
+    int boardOption; // índice do tabuleiro atual em BOARD_OPTIONS
     Player currentPlayer; // representa qual jogador está jogando no momento.
     bool gameOver; // indica se houve vitória/derrota
     sf::Font* font; 
+    
+    // HUD criado uma vez; o texto só é refeito quando o conteúdo muda
+    sf::Text* statusText;
+    sf::Text* difficultyText;
+    sf::Text* boardText;
+    sf::Text* buttonText;
+    sf::RectangleShape* button;
+    string statusString, difficultyString, boardString; // conteúdo atual de cada texto
+    
+    // Painel de telemetria da IA (tecla T) e exportação em JSON (tecla J)
+    bool showTelemetry;
+    sf::Text* telemetryText;
+    sf::RectangleShape* telemetryPanel;
+    string telemetryString;
+    Telemetry telemetrySnapshot; // copiado ao fim de cada jogada da IA, quando a thread dela está parada
+    uint64_t exportedDecisions;  // decisões de telemetrySnapshot já gravadas em telemetry.jsonl
+    
+    // Laço sob demanda: só acorda com entrada ou resultado da IA e só redesenha se algo mudou
+    struct LoopStats {
+        uint64_t wakeups = 0;       // Voltas do laço
+        uint64_t frames = 0;        // Quadros desenhados
+        int64_t frameMicros = 0;    // Soma da duração de render()
+        int64_t maxFrameMicros = 0;
+        int64_t idleMicros = 0;     // Tempo dormindo à espera de eventos
+    };
+    bool needsRender; // HUD mudou (evento, jogada ou fim de partida)
+    LoopStats loopStats;
     Difficulty currentDifficulty; // dificuldade atual da ia
     
-    void processEvents();
+    // A IA vive em outra thread: o laço de 60 fps só consulta os futuros
+    struct AIUpdate {           // mudanças ainda não repassadas à IA
+        bool reset = false;
+        bool difficultyChanged = false;
+        vector<pair<int, int>> moves;
+    };
+    future<AIPlayerBase*> aiLoading; // construção da IA (árvore, livro, banco de finais)
+    future<pair<int, int>> aiMove;   // jogada da IA sendo calculada
+    future<void> aiPonder;           // respostas calculadas durante a vez do humano
+    AIUpdate pendingUpdate;          // aplicado pela thread da busca no início da vez da IA
+    
+    void processEvents(); // bloqueia até chegar um evento (ou a IA precisar de atenção)
+    bool waitingOnAI() const; // resultado da IA pendente: a espera ganha prazo
+    void printLoopStats(double seconds) const;
     void update();
     void render(); // renderiza todos os objetos da tela.
     void handlePlayerClick(float x, float y);
@@ -35,7 +79,18 @@ private:
     void resetGame(); // reinicia o jogo.
     void displayGameStatus(); // mostra o status do jogo.
     void displayDifficulty(); // mostra a dificuldade do jogo atual.
+    void displayTelemetry(); // painel com o custo das decisões da IA.
+    void exportTelemetry(); // acrescenta as decisões novas em telemetry.jsonl.
     void cycleDifficulty(); // altera a dificuldade.
+    void cycleBoard(); // altera o tamanho do tabuleiro.
+    void createBoard(); // cria tabuleiro e IA para boardOption.
+    void createHud(); // cria os textos e o botão (precisa da fonte).
+    void setText(sf::Text* text, string& current, const string& value); // só troca se mudou.
+    void startAITurn(); // dispara a busca da IA em segundo plano.
+    void startPondering(); // IA pensa nas respostas enquanto o humano joga.
+    void cancelAITurn(); // interrompe busca e ponder e descarta a jogada.
+    static void applyUpdate(AIPlayerBase* ai, Difficulty difficulty, const AIUpdate& changes);
+    void releaseAI(); // espera a construção em andamento e libera a IA.
 };
 
 #endif
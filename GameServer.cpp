@@ -0,0 +1,429 @@
+#include "GameServer.h"
+#include "Logger.h"
+#include "SolvedTable.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+namespace {
+
+constexpr size_t MAX_LINE = 256;            // Linha maior que isso sem '\n' encerra a conexão
+constexpr size_t MAX_PENDING = 64 * 1024;   // Entrada ou saída acumulada por sessão
+constexpr int MAX_EVENTS = 256;
+
+string formatMove(int cell) {
+    return string(1, char('a' + cell % 3)) + to_string(cell / 3 + 1);
+}
+
+// Casa 0..8 de "a1".."c3"; -1 se inválida
+int parseMove(const string& text) {
+    if (text.size() != 2 || text[0] < 'a' || text[0] > 'c' || text[1] < '1' || text[1] > '3') return -1;
+    return (text[1] - '1') * 3 + (text[0] - 'a');
+}
+
+// " end x|o|draw" se a partida acabou, senão vazio
+const char* resultSuffix(const Bitboard& board) {
+    switch (board.winner()) {
+        case Player::X: return " end x";
+        case Player::O: return " end o";
+        default: return board.isFull() ? " end draw" : "";
+    }
+}
+
+int workerCount(int requested) {
+    return requested > 0 ? requested : int(max(1u, thread::hardware_concurrency()));
+}
+
+}
+
+GameServer::GameServer(const ServerOptions& options) : options(options), pool(workerCount(options.workers)) {
+    for (int i = 0; i < pool.size(); ++i) {
+        generators.emplace_back(uint32_t(options.seed * 1000003u + uint64_t(i)));
+    }
+}
+
+GameServer::~GameServer() {
+    pool.wait(); // jogadas ainda em cálculo escrevem em wakeFd
+    for (size_t fd = 0; fd < sessions.size(); ++fd) closeSession(int(fd));
+    if (unixFd >= 0) {
+        close(unixFd);
+        unlink(options.unixPath.c_str());
+    }
+    if (tcpFd >= 0) close(tcpFd);
+    if (wakeFd >= 0) close(wakeFd);
+    if (epollFd >= 0) close(epollFd);
+}
+
+bool GameServer::start() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        LOG_ERROR("epoll: {}", strerror(errno));
+        return false;
+    }
+    watch(EPOLL_CTL_ADD, wakeFd, true, false);
+
+    if (!options.unixPath.empty()) {
+        unixFd = listenUnix();
+        if (unixFd < 0) return false;
+        watch(EPOLL_CTL_ADD, unixFd, true, false);
+        LOG_INFO("Servidor escutando em {}", options.unixPath);
+    }
+    if (options.tcpPort > 0) {
+        tcpFd = listenTcp();
+        if (tcpFd < 0) return false;
+        watch(EPOLL_CTL_ADD, tcpFd, true, false);
+        LOG_INFO("Servidor escutando em 127.0.0.1:{}", options.tcpPort);
+    }
+    if (unixFd < 0 && tcpFd < 0) {
+        LOG_ERROR("nenhum socket: use --unix CAMINHO e/ou --tcp PORTA");
+        return false;
+    }
+    sessions.reserve(1024);
+    LOG_INFO("IA: tabela do jogo resolvido, {} threads", pool.size());
+    return true;
+}
+
+int GameServer::listenUnix() {
+    sockaddr_un address{};
+    if (options.unixPath.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("caminho longo demais para socket Unix: {}", options.unixPath);
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, options.unixPath.c_str(), options.unixPath.size() + 1);
+
+    // Socket deixado por uma execução anterior; outros arquivos não são apagados
+    struct stat info;
+    if (stat(options.unixPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(options.unixPath.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(fd, SOMAXCONN) < 0) {
+        LOG_ERROR("socket Unix {}: {}", options.unixPath, strerror(errno));
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Só na interface local: o servidor não é exposto à rede
+int GameServer::listenTcp() {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(uint16_t(options.tcpPort));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0 ||
+        bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        LOG_ERROR("porta TCP {}: {}", options.tcpPort, strerror(errno));
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void GameServer::stop() {
+    stopping = true;
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one)); // write é seguro em tratador de sinal
+    (void)ignored;
+}
+
+void GameServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (!stopping.load()) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("epoll_wait: {}", strerror(errno));
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                // Zera o contador antes de esvaziar a fila: resposta que chegar depois avisa de novo
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0) {}
+                drainReplies();
+            } else if (fd == unixFd || fd == tcpFd) {
+                acceptAll(fd);
+            } else {
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readSession(fd);
+                if (events[i].events & EPOLLOUT) {
+                    writeSession(fd);
+                    processLines(fd); // linhas seguradas enquanto a saída estava cheia
+                }
+            }
+        }
+    }
+    LOG_INFO("Servidor encerrado: {} partidas, {} jogadas da IA", gamesFinished, aiMoves);
+}
+
+void GameServer::acceptAll(int listenFd) {
+    for (;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) LOG_WARN("accept: {}", strerror(errno));
+            return;
+        }
+        if (listenFd == tcpFd) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        if (size_t(fd) >= sessions.size()) sessions.resize(size_t(fd) + 1);
+
+        Session& session = sessions[fd];
+        uint32_t generation = session.generation + 1;
+        session = Session();
+        session.open = true;
+        session.generation = generation;
+        ++openSessions;
+        watch(EPOLL_CTL_ADD, fd, true, false);
+    }
+}
+
+void GameServer::readSession(int fd) {
+    if (size_t(fd) >= sessions.size() || !sessions[fd].open) return;
+    Session& session = sessions[fd];
+    if (session.inputClosed) {
+        closeSession(fd); // EPOLLIN já desligado: só chega aqui com EPOLLHUP ou EPOLLERR
+        return;
+    }
+    char buffer[4096];
+    for (;;) {
+        ssize_t received = read(fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            session.input.append(buffer, size_t(received));
+            if (session.input.size() - session.cursor > MAX_PENDING) {
+                closeSession(fd); // cliente mandando mais do que lê
+                return;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received < 0) {
+            closeSession(fd);
+            return;
+        }
+
+        // Fim da entrada (shutdown do cliente): as linhas recebidas ainda são
+        // respondidas, inclusive uma última sem '\n'; a sessão fecha depois
+        if (session.input.size() > session.cursor && session.input.back() != '\n') session.input += '\n';
+        session.inputClosed = true;
+        watch(EPOLL_CTL_MOD, fd, false, session.waitingWrite);
+        break;
+    }
+    processLines(fd);
+}
+
+/*
+ * @brief Trata as linhas completas em ordem; para enquanto a IA pensa, para
+ * a resposta dela sair antes das respostas às linhas seguintes
+ */
+void GameServer::processLines(int fd) {
+    if (size_t(fd) >= sessions.size() || !sessions[fd].open) return;
+    Session& session = sessions[fd];
+    while (session.open && !session.thinking && !session.closing && session.output.size() < MAX_PENDING) {
+        size_t end = session.input.find('\n', session.cursor);
+        if (end == string::npos) {
+            if (session.input.size() - session.cursor > MAX_LINE) closeSession(fd);
+            break;
+        }
+        size_t length = end - session.cursor;
+        if (length > 0 && session.input[end - 1] == '\r') --length;
+        string line = session.input.substr(session.cursor, length);
+        session.cursor = end + 1;
+        handleLine(fd, line);
+    }
+    if (!session.open) return;
+
+    // Descarta o que já foi tratado
+    if (session.cursor == session.input.size()) {
+        session.input.clear();
+        session.cursor = 0;
+    } else if (session.cursor > MAX_LINE) {
+        session.input.erase(0, session.cursor);
+        session.cursor = 0;
+    }
+
+    // Entrada encerrada e toda tratada: fecha assim que a saída for enviada
+    if (session.inputClosed && !session.thinking && session.input.empty()) session.closing = true;
+    if (session.closing && session.output.empty()) closeSession(fd);
+    else if (!session.output.empty() && !session.waitingWrite) writeSession(fd);
+}
+
+void GameServer::handleLine(int fd, const string& line) {
+    Session& session = sessions[fd];
+    size_t space = line.find(' ');
+    string command = line.substr(0, space);
+    string argument = space == string::npos ? string() : line.substr(space + 1);
+
+    if (command == "play") {
+        int cell = parseMove(argument);
+        if (cell < 0) {
+            send(fd, "error jogada inválida: " + argument);
+        } else if (session.board.isGameOver()) {
+            send(fd, "error partida encerrada");
+        } else if (!session.board.isEmpty(cell / 3, cell % 3)) {
+            send(fd, "error casa ocupada: " + argument);
+        } else {
+            session.board.set(cell / 3, cell % 3, session.human);
+            const char* result = resultSuffix(session.board);
+            if (*result) {
+                ++gamesFinished;
+                send(fd, result + 1); // sem o espaço: "end x"
+            } else {
+                requestMove(fd);
+            }
+        }
+    } else if (command == "new") {
+        if (!argument.empty() && argument != "x" && argument != "o") {
+            send(fd, "error lado inválido: " + argument);
+            return;
+        }
+        session.board = Bitboard();
+        session.human = argument == "o" ? Player::O : Player::X;
+        if (session.human == Player::X) send(fd, "ok");
+        else requestMove(fd); // IA abre a partida
+    } else if (command == "stats") {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        int64_t cpuMicros = (int64_t(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000 +
+                            usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+        send(fd, "stats sessions " + to_string(openSessions) + " games " + to_string(gamesFinished) +
+                 " moves " + to_string(aiMoves) + " cpu_us " + to_string(cpuMicros));
+    } else if (command == "quit") {
+        session.closing = true; // processLines fecha depois de enviar a saída
+    } else if (!command.empty()) {
+        send(fd, "error comando desconhecido: " + command);
+    }
+}
+
+/*
+ * @brief A tarefa leva uma cópia do tabuleiro e devolve só a casa escolhida;
+ * só avisa o laço quando a fila estava vazia (senão o aviso já está a caminho)
+ */
+void GameServer::requestMove(int fd) {
+    Session& session = sessions[fd];
+    session.thinking = true;
+    Bitboard board = session.board;
+    uint32_t generation = session.generation;
+    pool.submit([this, fd, generation, board](int worker) {
+        uint16_t bestMoves = solvedEntry(int(board.rank())).bestMoves;
+        int cell = -1;
+        if (bestMoves) {
+            // Sorteia entre as jogadas ótimas, como a IA Difícil
+            uniform_int_distribution<int> dist(0, __builtin_popcount(bestMoves) - 1);
+            for (int skip = dist(generators[worker]); skip > 0; --skip) {
+                bestMoves &= uint16_t(bestMoves - 1);
+            }
+            cell = __builtin_ctz(bestMoves);
+        }
+
+        bool wasEmpty;
+        {
+            lock_guard<mutex> guard(repliesLock);
+            wasEmpty = replies.empty();
+            replies.push_back({fd, generation, cell});
+        }
+        if (wasEmpty) {
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    });
+}
+
+void GameServer::drainReplies() {
+    {
+        lock_guard<mutex> guard(repliesLock);
+        drained.swap(replies);
+    }
+    for (const Reply& reply : drained) applyReply(reply);
+    drained.clear();
+}
+
+void GameServer::applyReply(const Reply& reply) {
+    if (size_t(reply.fd) >= sessions.size()) return;
+    Session& session = sessions[reply.fd];
+    if (!session.open || session.generation != reply.generation || !session.thinking) return;
+    session.thinking = false;
+
+    if (reply.cell < 0) {
+        send(reply.fd, "error sem jogada");
+    } else {
+        session.board.set(reply.cell / 3, reply.cell % 3, session.human == Player::X ? Player::O : Player::X);
+        ++aiMoves;
+        const char* result = resultSuffix(session.board);
+        if (*result) ++gamesFinished;
+        send(reply.fd, "move " + formatMove(reply.cell) + result);
+    }
+    processLines(reply.fd); // envia a resposta e trata o que chegou enquanto a IA pensava
+}
+
+void GameServer::send(int fd, const string& line) {
+    Session& session = sessions[fd];
+    session.output += line;
+    session.output += '\n';
+}
+
+void GameServer::writeSession(int fd) {
+    if (size_t(fd) >= sessions.size() || !sessions[fd].open) return;
+    Session& session = sessions[fd];
+    size_t sent = 0;
+    while (sent < session.output.size()) {
+        ssize_t written = ::send(fd, session.output.data() + sent, session.output.size() - sent, MSG_NOSIGNAL);
+        if (written > 0) {
+            sent += size_t(written);
+            continue;
+        }
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        closeSession(fd);
+        return;
+    }
+    session.output.erase(0, sent);
+
+    // Espera o socket aceitar o resto só quando sobrou algo
+    bool wantWrite = !session.output.empty();
+    if (wantWrite != session.waitingWrite) {
+        session.waitingWrite = wantWrite;
+        watch(EPOLL_CTL_MOD, fd, !session.inputClosed, wantWrite);
+    }
+    if (!wantWrite && session.closing) closeSession(fd);
+}
+
+void GameServer::closeSession(int fd) {
+    Session& session = sessions[fd];
+    if (!session.open) return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    session.open = false;
+    string().swap(session.input); // milhares de sessões: não guarda buffers de conexões fechadas
+    string().swap(session.output);
+    --openSessions;
+}
+
+void GameServer::watch(int operation, int fd, bool wantRead, bool wantWrite) {
+    epoll_event event{};
+    event.events = (wantRead ? EPOLLIN : 0u) | (wantWrite ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    epoll_ctl(epollFd, operation, fd, &event);
+}
@@ -0,0 +1,109 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include "Bitboard.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * @struct ServerOptions
+ * @brief Onde o servidor escuta e quantas threads calculam as jogadas da IA
+ */
+struct ServerOptions {
+    string unixPath;        // Socket Unix (vazio = nenhum)
+    int tcpPort = 0;        // Porta TCP em 127.0.0.1 (0 = nenhuma)
+    int workers = 0;        // Threads da IA (0 = um por núcleo)
+    uint64_t seed = 1;      // Sorteio entre as jogadas ótimas
+};
+
+/*
+ * @class GameServer
+ * @brief Servidor local de muitas partidas 3x3 simultâneas (Linux, epoll)
+ *
+ * Protocolo por linha, uma partida por conexão; jogadas como no modo texto
+ * do motor (coluna em letra, linha de cima = 1):
+ * - new [x|o]: nova partida com o humano em X (padrão) ou O; responde "ok",
+ *   ou já a primeira jogada da IA quando o humano é O
+ * - play b2: responde "move a1", com " end x|o|draw" se a partida acabou,
+ *   ou só "end x|draw" quando a jogada do humano encerra a partida
+ * - stats: "stats sessions N games G moves M cpu_us C" (CPU do processo)
+ * - quit
+ *
+ * Uma thread com epoll cuida de todas as conexões; cada sessão guarda só o
+ * tabuleiro, o lado do humano e o cursor da próxima linha a tratar. A IA é a
+ * tabela do jogo resolvido (imutável, gerada na compilação, dividida por
+ * todas as sessões) e roda no ThreadPool; a resposta volta por uma fila e um
+ * eventfd. Enquanto a IA pensa, as linhas seguintes da sessão esperam no
+ * buffer, então o cliente pode mandar comandos em sequência sem esperar.
+ */
+class GameServer {
+public:
+    explicit GameServer(const ServerOptions& options);
+    ~GameServer();
+
+    bool start();   // abre os sockets; false (com mensagem no log) se falhar
+    void run();     // atende até stop()
+    void stop();    // pode ser chamado de outra thread ou de um tratador de sinal
+
+private:
+    struct Session {
+        bool open = false;
+        uint32_t generation = 0;    // Descarta respostas da IA para uma conexão já fechada
+        Bitboard board;
+        Player human = Player::X;
+        bool thinking = false;      // Jogada da IA em andamento: as linhas seguintes esperam
+        bool closing = false;       // Fecha depois de enviar o que falta
+        bool inputClosed = false;   // Cliente fechou a escrita: trata o que chegou e fecha
+        bool waitingWrite = false;  // EPOLLOUT ligado: o socket não aceitou tudo
+        size_t cursor = 0;          // Início da próxima linha em input
+        string input;
+        string output;              // Resposta que o socket ainda não aceitou
+    };
+
+    struct Reply {
+        int fd;
+        uint32_t generation;
+        int cell;                   // -1: posição sem jogada
+    };
+
+    ServerOptions options;
+    int epollFd = -1;
+    int wakeFd = -1;                // eventfd: respostas da IA ou stop()
+    int unixFd = -1;
+    int tcpFd = -1;
+    atomic<bool> stopping{false};
+
+    vector<Session> sessions;       // Indexado pelo descritor da conexão
+    int openSessions = 0;
+    uint64_t gamesFinished = 0;
+    uint64_t aiMoves = 0;
+
+    mutex repliesLock;
+    vector<Reply> replies;          // Preenchido pelas threads da IA
+    vector<Reply> drained;
+    vector<mt19937> generators;     // Um por thread do pool
+
+    ThreadPool pool;                // Por último: termina antes dos membros que as tarefas usam
+
+    int listenUnix();
+    int listenTcp();
+    void acceptAll(int listenFd);
+    void readSession(int fd);
+    void writeSession(int fd);
+    void closeSession(int fd);
+    void processLines(int fd);                  // trata as linhas completas e envia as respostas
+    void handleLine(int fd, const string& line);
+    void requestMove(int fd);                   // manda a jogada da IA para o pool
+    void drainReplies();
+    void applyReply(const Reply& reply);
+    void send(int fd, const string& line);      // só acumula; processLines envia
+    void watch(int operation, int fd, bool wantRead, bool wantWrite);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "GameTree.h"
+using namespace std;
+
+/*
+ * @brief Árvore compartilhada: a inicialização de estáticos locais é thread-safe,
+ * então a construção acontece uma única vez mesmo com várias threads
+ */
+shared_ptr<const GameTree> GameTree::shared() {
+    static const shared_ptr<const GameTree> instance = make_shared<const GameTree>();
+    return instance;
+}
+
+size_t GameTree::memoryBytes() const {
+    return nodes.capacity() * sizeof(GameState) + edges.capacity() * sizeof(TreeEdge) +
+           positionIndex.capacity() * sizeof(uint32_t);
+}
+
+GameTree::GameTree() : positionIndex(Bitboard::NUM_RANKS, NO_NODE) {
+    nodes.reserve(1024);
+    edges.reserve(2048);
+
+    bool created;
+    uint32_t root = findOrCreate(Bitboard(), Player::X, NO_NODE, created);
+    buildGameTree(root);
+
+    nodes.shrink_to_fit();
+    edges.shrink_to_fit();
+}
+
+uint32_t GameTree::find(const Bitboard& canonicalBoard) const {
+    return positionIndex[canonicalBoard.rank()];
+}
+
+/*
+ * @brief Retorna o nó da posição, criando-o no fim da arena caso ainda não exista
+ */
+uint32_t GameTree::findOrCreate(const Bitboard& canonicalBoard, Player player, uint32_t parent, bool& created) {
+    uint32_t index = positionIndex[canonicalBoard.rank()];
+    created = (index == NO_NODE);
+    if (!created) return index;
+
+    index = uint32_t(nodes.size());
+    nodes.push_back(GameState{ canonicalBoard, player, parent, 0, 0 });
+    positionIndex[canonicalBoard.rank()] = index;
+    return index;
+}
+
+void GameTree::buildGameTree(uint32_t state) {
+    if (nodes[state].board.isGameOver()) return;
+
+    // Os filhos são gerados jogando e desfazendo sobre a mesma posição
+    Position<3, 3, 3> position(nodes[state].board);
+    Player player = nodes[state].currentPlayer;
+    Player opponent = (player == Player::X) ? Player::O : Player::X;
+
+    // Todos os filhos deste nó entram juntos no fim da arena de arestas
+    uint32_t first = uint32_t(edges.size());
+    uint8_t count = 0;
+    vector<uint32_t> newChildren;
+
+    uint16_t empty = position.getBoard().emptyCells();
+    while (empty) {
+        int cell = __builtin_ctz(empty);
+        empty &= empty - 1;
+
+        // Transposições e posições simétricas reaproveitam o mesmo nó canônico
+        position.makeMove(cell, player);
+        int transform;
+        bool created;
+        uint32_t child = findOrCreate(position.getBoard().canonical(transform), opponent, state, created);
+        position.unmakeMove();
+
+        // Jogadas simétricas (ex.: os 4 cantos na abertura) viram um único filho
+        bool duplicate = false;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (edges[first + i].child == child) duplicate = true;
+        }
+        if (duplicate) continue;
+
+        edges.push_back(TreeEdge{ child, uint8_t(cell) });
+        ++count;
+        if (created) newChildren.push_back(child);
+    }
+
+    nodes[state].firstChild = first;
+    nodes[state].childCount = count;
+
+    // Desce um nível depois que todos os irmãos já estão alocados lado a lado
+    for (uint32_t child : newChildren) {
+        buildGameTree(child);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef GAMETREE_H
+#define GAMETREE_H
+
+#include "Position.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+using namespace std;
+
+/*
+ * @struct GameState
+ * @brief Representa um nó no grafo de estados do jogo
+ *
+ * Posições alcançadas por ordens de jogadas diferentes (transposições)
+ * compartilham o mesmo nó, então a "árvore" é na prática um DAG. O tabuleiro
+ * fica sempre na forma canônica entre as 8 simetrias do quadrado.
+ * Ligações são índices de 32 bits dentro da arena, não ponteiros.
+ */
+struct GameState {
+    Bitboard board;             // Tabuleiro 3x3 na forma canônica
+    Player currentPlayer;       // Jogador que deve jogar neste estado
+    uint32_t parent;            // Nó que criou este estado (NO_NODE na raiz)
+    uint32_t firstChild;        // Primeira aresta filha; os irmãos ficam adjacentes
+    uint8_t childCount;         // Quantidade de filhos (zero em posições encerradas)
+};
+
+/*
+ * @struct TreeEdge
+ * @brief Aresta pai -> filho com a casa jogada (coordenadas canônicas do pai)
+ */
+struct TreeEdge {
+    uint32_t child;
+    uint8_t move;
+};
+
+/*
+ * @class GameTree
+ * @brief Árvore completa do jogo, imutável e compartilhada por todo o processo
+ *
+ * Nós e arestas vivem em blocos contíguos de memória. Os filhos de um nó são
+ * gerados juntos (em largura), então ficam lado a lado na arena.
+ *
+ * Com transposições e simetrias a árvore completa tem 765 nós, então ela é
+ * construída uma única vez (shared()) e nunca mais alterada: qualquer número
+ * de AIPlayer, em qualquer thread, lê a mesma instância e guarda apenas um
+ * cursor (índice do nó atual).
+ */
+class GameTree {
+public:
+    static constexpr uint32_t NO_NODE = 0xFFFFFFFFu;
+
+    static shared_ptr<const GameTree> shared(); // instância única, construída no primeiro uso
+
+    GameTree(); // constrói a árvore completa a partir do tabuleiro vazio
+
+    uint32_t find(const Bitboard& canonicalBoard) const; // NO_NODE se ausente
+
+    uint32_t getRoot() const { return 0; }
+    const GameState& getNode(uint32_t index) const { return nodes[index]; }
+    const TreeEdge* getChildren(uint32_t index) const { return edges.data() + nodes[index].firstChild; }
+    uint32_t size() const { return uint32_t(nodes.size()); }
+    size_t memoryBytes() const; // arenas e índice
+
+private:
+    vector<GameState> nodes;        // Arena de nós
+    vector<TreeEdge> edges;         // Arena de arestas
+    vector<uint32_t> positionIndex; // Índice ternário da forma canônica -> nó
+
+    void buildGameTree(uint32_t state);
+    uint32_t findOrCreate(const Bitboard& canonicalBoard, Player player, uint32_t parent, bool& created);
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "Logger.h"
+#include <iostream>
+using namespace std;
+
+atomic<uint8_t> Logger::runtimeLevel{uint8_t(LogLevel::INFO)};
+
+namespace {
+
+const char* levelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "trace";
+        case LogLevel::DEBUG: return "debug";
+        case LogLevel::WARN: return "AVISO: ";
+        case LogLevel::ERROR: return "ERRO: ";
+        default: return "";
+    }
+}
+
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : cells(new Cell[CAPACITY]), output(&cout), started(chrono::steady_clock::now()) {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY precisa ser potência de 2");
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+    writer = thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    running = false;
+    {
+        lock_guard<mutex> guard(wakeLock);
+        wake.notify_one();
+    }
+    writer.join();
+}
+
+bool Logger::parseLevel(const string& name, LogLevel& level) {
+    static const char* NAMES[] = {"trace", "debug", "info", "warn", "error", "off"};
+    for (int i = 0; i <= int(LogLevel::OFF); ++i) {
+        if (name == NAMES[i]) {
+            level = LogLevel(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::setOutput(ostream& out) {
+    flush();
+    lock_guard<mutex> guard(outputLock);
+    output = &out;
+}
+
+/*
+ * @brief Espera a thread de escrita alcançar tudo o que já foi enfileirado e
+ * terminar o lote (outputLock), para a saída poder ser lida ou trocada
+ */
+void Logger::flush() {
+    uint64_t target = enqueuePos.load(memory_order_acquire);
+    while (written.load(memory_order_acquire) < target) {
+        {
+            lock_guard<mutex> guard(wakeLock);
+            wake.notify_one();
+        }
+        this_thread::sleep_for(chrono::microseconds(200));
+    }
+    lock_guard<mutex> guard(outputLock);
+}
+
+void Logger::packString(Record& record, Arg& arg, const char* text, size_t length) {
+    size_t room = STRING_BYTES - record.stringsUsed;
+    if (room == 0) {
+        arg.offset = STRING_BYTES - 1; // aponta para o terminador do último texto
+        return;
+    }
+    if (length > room - 1) length = room - 1; // texto longo é cortado
+    memcpy(record.strings + record.stringsUsed, text, length);
+    record.strings[record.stringsUsed + length] = '\0';
+    arg.offset = record.stringsUsed;
+    record.stringsUsed += uint32_t(length + 1);
+}
+
+/*
+ * @brief Fila limitada de Vyukov: cada célula tem um número de sequência que
+ * diz se ela está livre para a volta atual (produtor) ou já preenchida
+ * (consumidor); produtores disputam só o incremento de enqueuePos
+ */
+bool Logger::push(Record& record) {
+    size_t position = enqueuePos.load(memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[position & (CAPACITY - 1)];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        intptr_t difference = intptr_t(sequence) - intptr_t(position);
+        if (difference == 0) {
+            if (enqueuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            return false; // Fila cheia
+        } else {
+            position = enqueuePos.load(memory_order_relaxed);
+        }
+    }
+    cell->record = record;
+    cell->sequence.store(position + 1, memory_order_release);
+
+    // Só paga o aviso (e a trava) quando a thread de escrita está dormindo;
+    // a barreira garante que ela veja o registro ou que este produtor veja sleeping
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleeping.load(memory_order_relaxed)) {
+        lock_guard<mutex> guard(wakeLock);
+        wake.notify_one();
+    }
+    return true;
+}
+
+bool Logger::hasPending() const {
+    return cells[dequeuePos & (CAPACITY - 1)].sequence.load() == dequeuePos + 1;
+}
+
+bool Logger::pop(Record& record) {
+    Cell& cell = cells[dequeuePos & (CAPACITY - 1)];
+    if (cell.sequence.load(memory_order_acquire) != dequeuePos + 1) return false;
+    record = cell.record;
+    cell.sequence.store(dequeuePos + CAPACITY, memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+/*
+ * @brief Esvazia a fila em lotes e dorme quando não há nada; antes de dormir
+ * marca sleeping e confere a fila de novo, com a trava, para não perder aviso
+ */
+void Logger::writerLoop() {
+    Record record;
+    uint64_t reportedDrops = 0;
+    for (;;) {
+        {
+            lock_guard<mutex> guard(outputLock);
+            bool any = false;
+            while (pop(record)) {
+                write(record);
+                written.fetch_add(1, memory_order_release);
+                any = true;
+            }
+            uint64_t drops = dropped.load(memory_order_relaxed);
+            if (drops != reportedDrops) {
+                *output << "[log] " << drops - reportedDrops << " mensagens descartadas (fila cheia)\n";
+                reportedDrops = drops;
+                any = true;
+            }
+            if (any) output->flush();
+        }
+
+        if (!running.load() && !hasPending()) break;
+
+        unique_lock<mutex> guard(wakeLock);
+        sleeping.store(true);
+        if (running.load() && !hasPending()) {
+            wake.wait_for(guard, chrono::seconds(1));
+        }
+        sleeping.store(false);
+    }
+}
+
+// Troca cada {} do formato pelo próximo argumento; depuração leva o instante
+void Logger::write(const Record& record) {
+    ostream& out = *output;
+    if (record.level <= LogLevel::DEBUG) {
+        out << "[" << levelPrefix(record.level) << " " << record.micros / 1000.0 << " ms] ";
+    } else {
+        out << levelPrefix(record.level);
+    }
+    int next = 0;
+    for (const char* c = record.format; *c; ++c) {
+        if (c[0] == '{' && c[1] == '}' && next < record.argc) {
+            const Arg& arg = record.args[next++];
+            switch (arg.type) {
+                case Arg::INT: out << arg.i; break;
+                case Arg::UINT: out << arg.u; break;
+                case Arg::DOUBLE: out << arg.d; break;
+                case Arg::STRING: out << record.strings + arg.offset; break;
+            }
+            ++c;
+        } else {
+            out << *c;
+        }
+    }
+    out << '\n';
+}
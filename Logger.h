@@ -0,0 +1,176 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+using namespace std;
+
+enum class LogLevel : uint8_t { TRACE, DEBUG, INFO, WARN, ERROR, OFF };
+
+/*
+ * Nível mínimo compilado: chamadas abaixo dele somem do binário (nem os
+ * argumentos são avaliados). Ex.: -DLOG_MIN_LEVEL=3 deixa só WARN e ERROR.
+ */
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+// O + 1 evita o aviso de comparação sempre verdadeira com LOG_MIN_LEVEL 0 (-Wtype-limits)
+constexpr bool logCompiled(LogLevel level) { return static_cast<int>(level) + 1 > LOG_MIN_LEVEL; }
+
+#define LOG_AT(level, ...) \
+    do { \
+        if constexpr (logCompiled(level)) { \
+            if (Logger::enabled(level)) Logger::instance().log(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// Formato literal com {} para cada argumento: LOG_INFO("IA jogou em {}, {}", row, col)
+#define LOG_TRACE(...) LOG_AT(LogLevel::TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERROR, __VA_ARGS__)
+
+/*
+ * @class Logger
+ * @brief Log assíncrono: quem chama só enfileira, uma thread formata e escreve
+ *
+ * - Fila circular sem travas de tamanho fixo (vários produtores, um
+ *   consumidor): registrar é copiar o ponteiro do formato, os números e
+ *   até STRING_BYTES de texto; fila cheia descarta e conta, nunca bloqueia
+ * - O formato precisa ser literal (só o ponteiro é guardado); strings nos
+ *   argumentos são copiadas para o registro
+ * - A thread de escrita dorme quando a fila esvazia e só é acordada se
+ *   estiver dormindo
+ * - Nível em tempo de execução (setLevel) e de compilação (LOG_MIN_LEVEL)
+ */
+class Logger {
+public:
+    static constexpr size_t CAPACITY = 1024;    // Registros na fila (potência de 2)
+    static constexpr int MAX_ARGS = 8;
+    static constexpr size_t STRING_BYTES = 96;  // Texto copiado por registro
+
+    static Logger& instance(); // criado no primeiro uso; a thread de escrita nasce junto
+    ~Logger();                 // escreve o que restou na fila
+
+    static bool enabled(LogLevel level) {
+        return uint8_t(level) >= runtimeLevel.load(memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level) { runtimeLevel.store(uint8_t(level), memory_order_relaxed); }
+    static bool parseLevel(const string& name, LogLevel& level); // "trace" ... "off"
+
+    void setOutput(ostream& out); // padrão: cout
+    void flush();                 // espera a fila esvaziar
+
+    template <class... Args>
+    void log(LogLevel level, const char* format, const Args&... args);
+
+private:
+    struct Arg {
+        enum Type : uint8_t { INT, UINT, DOUBLE, STRING } type;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            uint32_t offset; // posição do texto em Record::strings
+        };
+    };
+
+    struct Record {
+        int64_t micros;         // Desde a criação do logger
+        const char* format;
+        LogLevel level;
+        uint8_t argc;
+        uint32_t stringsUsed;
+        Arg args[MAX_ARGS];
+        char strings[STRING_BYTES];
+    };
+
+    struct Cell {
+        atomic<size_t> sequence;
+        Record record;
+    };
+
+    static atomic<uint8_t> runtimeLevel;
+
+    unique_ptr<Cell[]> cells;
+    alignas(64) atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;       // Só a thread de escrita mexe
+    atomic<uint64_t> dropped{0};
+    atomic<uint64_t> written{0};             // Registros já escritos (flush compara)
+    atomic<bool> sleeping{false};
+    atomic<bool> running{true};
+    mutex wakeLock;
+    condition_variable wake;
+    mutex outputLock;                        // Lote em escrita; produtores nunca a tomam
+    ostream* output;
+    chrono::steady_clock::time_point started;
+    thread writer;
+
+    Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    bool push(Record& record);
+    bool pop(Record& record);
+    bool hasPending() const; // só na thread de escrita
+    void writerLoop();
+    void write(const Record& record);
+
+    // Converte cada argumento sem formatar: números por valor, texto copiado
+    template <class T>
+    static void pack(Record& record, const T& value) {
+        if (record.argc >= MAX_ARGS) return;
+        Arg& arg = record.args[record.argc++];
+        if constexpr (is_same_v<T, bool>) {
+            arg.type = Arg::STRING;
+            packString(record, arg, value ? "true" : "false");
+        } else if constexpr (is_floating_point_v<T>) {
+            arg.type = Arg::DOUBLE;
+            arg.d = double(value);
+        } else if constexpr (is_integral_v<T> && is_signed_v<T>) {
+            arg.type = Arg::INT;
+            arg.i = int64_t(value);
+        } else if constexpr (is_integral_v<T> || is_enum_v<T>) {
+            arg.type = Arg::UINT;
+            arg.u = uint64_t(value);
+        } else {
+            arg.type = Arg::STRING;
+            packString(record, arg, value);
+        }
+    }
+
+    static void packString(Record& record, Arg& arg, const string& text) {
+        packString(record, arg, text.c_str(), text.size());
+    }
+    static void packString(Record& record, Arg& arg, const char* text) {
+        packString(record, arg, text, strlen(text));
+    }
+    static void packString(Record& record, Arg& arg, const char* text, size_t length);
+};
+
+template <class... Args>
+void Logger::log(LogLevel level, const char* format, const Args&... args) {
+    Record record;
+    record.micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - started).count();
+    record.format = format;
+    record.level = level;
+    record.argc = 0;
+    record.stringsUsed = 0;
+    (pack(record, args), ...);
+    if (!push(record)) {
+        dropped.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+#endif
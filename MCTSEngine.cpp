@@ -0,0 +1,326 @@
+#include "MCTSEngine.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+template <int Rows, int Cols, int K>
+MCTSEngine<Rows, Cols, K>::MCTSEngine() {
+}
+
+template <int Rows, int Cols, int K>
+MCTSEngine<Rows, Cols, K>::~MCTSEngine() {
+}
+
+template <int Rows, int Cols, int K>
+const MCTSStats& MCTSEngine<Rows, Cols, K>::getStats() const {
+    return stats;
+}
+
+template <int Rows, int Cols, int K>
+size_t MCTSEngine<Rows, Cols, K>::treeNodes() const {
+    size_t total = 0;
+    for (const auto& tree : trees) {
+        if (tree) total += tree->nodes.size();
+    }
+    return total;
+}
+
+template <int Rows, int Cols, int K>
+size_t MCTSEngine<Rows, Cols, K>::memoryBytes() const {
+    size_t total = 0;
+    for (const auto& tree : trees) {
+        if (tree) total += sizeof(Tree) + tree->nodes.capacity() * sizeof(Node);
+    }
+    return total;
+}
+
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::prepare() {
+    stopRequested = false;
+}
+
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::stop() {
+    stopRequested = true;
+    stopped = true;
+}
+
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::clearTree(Tree& tree) {
+    tree.nodes.clear();
+    tree.nodes.push_back(Node{ NO_NODE, 0, 0, 0.f, 0, 0, false });
+}
+
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::reset() {
+    rootBoard = Board();
+    for (auto& tree : trees) clearTree(*tree);
+}
+
+/*
+ * @brief Desce a raiz para o filho jogado; sem esse filho, recomeça do zero
+ * @param board posição depois da jogada
+ */
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::advance(const Board& board, int cell) {
+    Board expected = rootBoard;
+    expected.set(cell / Cols, cell % Cols, playerToMove(rootBoard));
+    bool follows = (expected == board);
+    rootBoard = board;
+
+    for (auto& tree : trees) {
+        uint32_t child = NO_NODE;
+        const Node& root = tree->nodes[0];
+        for (uint32_t i = 0; follows && i < root.childCount; ++i) {
+            if (tree->nodes[root.firstChild + i].move == cell) child = root.firstChild + i;
+        }
+        if (child == NO_NODE) clearTree(*tree);
+        else reroot(*tree, child);
+    }
+}
+
+/*
+ * @brief Copia a subárvore de newRoot para uma arena nova, em largura, para
+ * os irmãos continuarem adjacentes; o resto da árvore antiga é descartado
+ */
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::reroot(Tree& tree, uint32_t newRoot) {
+    vector<Node> kept;
+    kept.reserve(tree.nodes.size());
+    kept.push_back(tree.nodes[newRoot]);
+    kept[0].parent = NO_NODE;
+
+    for (uint32_t i = 0; i < kept.size(); ++i) {
+        uint32_t oldFirst = kept[i].firstChild;
+        uint32_t first = uint32_t(kept.size());
+        for (uint32_t c = 0; c < kept[i].childCount; ++c) {
+            Node child = tree.nodes[oldFirst + c];
+            child.parent = i;
+            kept.push_back(child);
+        }
+        kept[i].firstChild = first;
+    }
+    tree.nodes.swap(kept);
+}
+
+template <int Rows, int Cols, int K>
+int MCTSEngine<Rows, Cols, K>::search(const Board& board, const MCTSLimits& limits, uint32_t seed) {
+    auto start = chrono::steady_clock::now();
+    stats = MCTSStats();
+    // Zera antes de ler o pedido: um stop() concorrente deixa um dos dois ligado
+    stopped = false;
+    if (stopRequested) stopped = true;
+
+    if (!anyBit(board.emptyCells()) || board.winner() != Player::NONE) {
+        return -1;
+    }
+
+    // Vitória imediata dispensa simulações
+    Pos probe(board);
+    Player toMove = probe.sideToMove();
+    typename Board::Mask candidates = board.candidateMoves();
+    while (anyBit(candidates)) {
+        int cell = lowestBit(candidates);
+        clearLowest(candidates);
+        probe.makeMove(cell, toMove);
+        bool wins = probe.getWinner() == toMove;
+        probe.unmakeMove();
+        if (wins) return cell;
+    }
+
+    int threads = max(1, limits.threads);
+    if (!(board == rootBoard)) reset();
+    rootBoard = board;
+    trees.resize(threads);
+    for (int t = 0; t < threads; ++t) {
+        if (!trees[t]) {
+            trees[t] = make_unique<Tree>();
+            clearTree(*trees[t]);
+        }
+        Tree& tree = *trees[t];
+        stats.reusedNodes += tree.nodes.size() - 1;
+        tree.position = Pos(board);
+        tree.rng.seed(seed + 0x9E3779B9u * uint32_t(t));
+        tree.playouts = 0;
+    }
+
+    auto deadline = start + limits.timeBudget;
+    if (threads == 1) {
+        runPlayouts(*trees[0], limits.playouts, limits, deadline);
+    } else {
+        if (!pool || pool->size() != threads) pool = make_unique<ThreadPool>(threads);
+        for (int t = 0; t < threads; ++t) {
+            uint64_t share = limits.playouts / threads + (uint32_t(t) < limits.playouts % threads ? 1 : 0);
+            Tree* tree = trees[t].get();
+            pool->submit([this, tree, share, &limits, deadline](int) {
+                runPlayouts(*tree, share, limits, deadline);
+            });
+        }
+        pool->wait();
+    }
+
+    // Soma as visitas dos filhos da raiz de todas as árvores: vence a mais visitada
+    uint64_t visits[CELLS] = {};
+    for (const auto& tree : trees) {
+        const Node& root = tree->nodes[0];
+        for (uint32_t i = 0; i < root.childCount; ++i) {
+            const Node& child = tree->nodes[root.firstChild + i];
+            visits[child.move] += child.visits;
+        }
+        stats.playouts += tree->playouts;
+        stats.nodes += tree->nodes.size();
+    }
+
+    int bestCell = -1;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (visits[cell] > 0 && (bestCell < 0 || visits[cell] > visits[bestCell])) bestCell = cell;
+    }
+    if (bestCell < 0) bestCell = lowestBit(board.candidateMoves());
+
+    stats.elapsedMicros = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - start).count();
+    return bestCell;
+}
+
+/*
+ * @brief Seleção, expansão, simulação e retropropagação, repetidas até o orçamento
+ */
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::runPlayouts(Tree& tree, uint64_t playouts, const MCTSLimits& limits,
+                                            chrono::steady_clock::time_point deadline) {
+    Pos& position = tree.position;
+    for (uint64_t i = 0; i < playouts; ++i) {
+        // Consultar o relógio é caro: só a cada 64 simulações
+        if (limits.timeBudget.count() > 0 && (i & 63) == 0 && chrono::steady_clock::now() >= deadline) break;
+        if (stopped.load(memory_order_relaxed)) break;
+
+        uint32_t node = 0;
+        int depth = 0;
+        while (tree.nodes[node].expanded && tree.nodes[node].childCount > 0) {
+            node = select(tree, node, limits.exploration);
+            position.makeMove(tree.nodes[node].move, position.sideToMove());
+            ++depth;
+        }
+
+        if (!tree.nodes[node].expanded) {
+            expand(tree, node);
+            if (tree.nodes[node].childCount > 0) {
+                node = tree.nodes[node].firstChild;
+                position.makeMove(tree.nodes[node].move, position.sideToMove());
+                ++depth;
+            }
+        }
+
+        Player winner = position.isGameOver() ? position.getWinner() : playout(tree);
+
+        // Quem jogou para chegar a cada nó recebe 1 (vitória), 0,5 (empate) ou 0
+        Player mover = (position.sideToMove() == Player::X) ? Player::O : Player::X;
+        for (uint32_t n = node; n != NO_NODE; n = tree.nodes[n].parent) {
+            Node& current = tree.nodes[n];
+            ++current.visits;
+            current.value += (winner == Player::NONE) ? 0.5f : (winner == mover ? 1.f : 0.f);
+            mover = (mover == Player::X) ? Player::O : Player::X;
+        }
+
+        while (depth-- > 0) position.unmakeMove();
+        ++tree.playouts;
+    }
+}
+
+/*
+ * @brief UCT: filhos ainda não visitados primeiro (a ordem já é aleatória),
+ * depois o maior valor médio + c * sqrt(ln N / n)
+ */
+template <int Rows, int Cols, int K>
+uint32_t MCTSEngine<Rows, Cols, K>::select(const Tree& tree, uint32_t node, float exploration) const {
+    const Node& parent = tree.nodes[node];
+    float logVisits = log(float(parent.visits));
+    uint32_t best = parent.firstChild;
+    float bestScore = -1.f;
+
+    for (uint32_t i = 0; i < parent.childCount; ++i) {
+        uint32_t index = parent.firstChild + i;
+        const Node& child = tree.nodes[index];
+        if (child.visits == 0) return index;
+
+        float score = child.value / child.visits + exploration * sqrt(logVisits / child.visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = index;
+        }
+    }
+    return best;
+}
+
+/*
+ * @brief Gera todos os filhos do nó juntos no fim da arena, em ordem aleatória;
+ * com a arena cheia o nó continua folha e só recebe simulações
+ */
+template <int Rows, int Cols, int K>
+void MCTSEngine<Rows, Cols, K>::expand(Tree& tree, uint32_t node) {
+    const Pos& position = tree.position;
+    if (position.isGameOver()) {
+        tree.nodes[node].expanded = true;
+        return;
+    }
+
+    typename Board::Mask candidates = position.getBoard().candidateMoves();
+    int count = bitCount(candidates);
+    if (tree.nodes.size() + count > MAX_NODES) return;
+
+    uint16_t moves[CELLS];
+    for (int i = 0; i < count; ++i) {
+        moves[i] = uint16_t(lowestBit(candidates));
+        clearLowest(candidates);
+    }
+    for (int i = count - 1; i > 0; --i) {
+        swap(moves[i], moves[tree.rng() % (i + 1)]);
+    }
+
+    uint32_t first = uint32_t(tree.nodes.size());
+    for (int i = 0; i < count; ++i) {
+        tree.nodes.push_back(Node{ node, 0, 0, 0.f, 0, moves[i], false });
+    }
+    tree.nodes[node].firstChild = first;
+    tree.nodes[node].childCount = uint16_t(count);
+    tree.nodes[node].expanded = true;
+}
+
+/*
+ * @brief Simulação leve: jogadas aleatórias entre as casas vazias até alguém
+ * vencer ou o tabuleiro encher; a posição volta ao estado inicial no fim
+ */
+template <int Rows, int Cols, int K>
+Player MCTSEngine<Rows, Cols, K>::playout(Tree& tree) {
+    Pos& position = tree.position;
+    int count = 0;
+    typename Board::Mask empty = position.getBoard().emptyCells();
+    while (anyBit(empty)) {
+        tree.emptyCells[count++] = uint16_t(lowestBit(empty));
+        clearLowest(empty);
+    }
+
+    Player winner = Player::NONE;
+    int played = 0;
+    while (count > 0) {
+        int pick = int(tree.rng() % uint32_t(count));
+        int cell = tree.emptyCells[pick];
+        tree.emptyCells[pick] = tree.emptyCells[--count];
+
+        position.makeMove(cell, position.sideToMove());
+        ++played;
+        if (position.getWinner() != Player::NONE) {
+            winner = position.getWinner();
+            break;
+        }
+    }
+
+    while (played-- > 0) position.unmakeMove();
+    return winner;
+}
+
+// Tabuleiros suportados pelo jogo
+template class MCTSEngine<3, 3, 3>;
+template class MCTSEngine<4, 4, 4>;
+template class MCTSEngine<5, 5, 4>;
+template class MCTSEngine<15, 15, 5>;
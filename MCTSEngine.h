@@ -0,0 +1,109 @@
+#ifndef MCTSENGINE_H
+#define MCTSENGINE_H
+
+#include "Position.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+using namespace std;
+
+/*
+ * @struct MCTSLimits
+ * @brief Orçamento da busca Monte Carlo: simulações, tempo e árvores paralelas
+ *
+ * Zero em timeBudget significa "sem prazo". O número de simulações é o botão
+ * que troca força por tempo de resposta.
+ */
+struct MCTSLimits {
+    uint32_t playouts = 20000;                  // Simulações por jogada (somando todas as threads)
+    chrono::microseconds timeBudget{0};         // Prazo por jogada
+    int threads = 1;                            // Uma árvore por thread, somadas no fim
+    float exploration = 1.4f;                   // Constante c do UCT
+};
+
+/*
+ * @struct MCTSStats
+ * @brief Estatísticas da última busca Monte Carlo
+ */
+struct MCTSStats {
+    uint64_t playouts = 0;      // Simulações feitas
+    uint64_t nodes = 0;         // Nós nas árvores ao fim da busca
+    uint64_t reusedNodes = 0;   // Nós herdados da jogada anterior
+    int64_t elapsedMicros = 0;  // Duração total da busca
+};
+
+/*
+ * @class MCTSEngine
+ * @brief Busca em árvore Monte Carlo (UCT) com simulações aleatórias leves
+ *
+ * - Seleção pelo UCT, expansão de todos os filhos de uma vez (em ordem
+ *   aleatória) e simulação com jogadas aleatórias até o fim da partida
+ * - A árvore sobrevive entre as jogadas: advance() desce para o filho jogado
+ *   e descarta o resto, compactando a arena
+ * - Paralelismo na raiz: cada thread tem sua própria árvore e gerador
+ *   aleatório, e as visitas dos filhos da raiz são somadas no fim
+ * - Nós em arena contígua com índices de 32 bits (como a GameTree)
+ */
+template <int Rows, int Cols, int K>
+class MCTSEngine {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    using Pos = Position<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr uint32_t NO_NODE = 0xFFFFFFFFu;
+    static constexpr uint32_t MAX_NODES = 1u << 19; // por árvore (~12 MB)
+
+    MCTSEngine();
+    ~MCTSEngine();
+
+    // retorna a casa escolhida (-1 se não houver); seed torna a busca reprodutível
+    int search(const Board& board, const MCTSLimits& limits, uint32_t seed);
+    void advance(const Board& board, int cell); // reaproveita a subárvore da jogada feita
+    void reset();
+    void prepare(); // antes de despachar a busca: esquece um stop() anterior
+    void stop(); // interrompe a busca em andamento ou a próxima (pode ser chamada de outra thread)
+    const MCTSStats& getStats() const;
+    size_t treeNodes() const;   // nós mantidos em todas as árvores
+    size_t memoryBytes() const; // arenas das árvores
+
+private:
+    struct Node {
+        uint32_t parent;
+        uint32_t firstChild;    // Filhos adjacentes na arena
+        uint32_t visits;
+        float value;            // Soma das recompensas de quem jogou para chegar aqui
+        uint16_t childCount;
+        uint16_t move;          // Casa jogada a partir do pai
+        bool expanded;          // Filhos já gerados (posição final: expandido sem filhos)
+    };
+
+    // Estado próprio de cada thread
+    struct Tree {
+        vector<Node> nodes;     // nodes[0] é a raiz
+        Pos position;           // Posição da raiz; os caminhos jogam e desfazem sobre ela
+        mt19937 rng;
+        uint64_t playouts = 0;
+        uint16_t emptyCells[CELLS];
+    };
+
+    vector<unique_ptr<Tree>> trees;
+    unique_ptr<ThreadPool> pool;
+    Board rootBoard;            // Posição que as árvores representam
+    MCTSStats stats;
+    atomic<bool> stopped{false};
+    atomic<bool> stopRequested{false}; // stop() até o próximo prepare(); search não apaga
+
+    void runPlayouts(Tree& tree, uint64_t playouts, const MCTSLimits& limits,
+                     chrono::steady_clock::time_point deadline);
+    uint32_t select(const Tree& tree, uint32_t node, float exploration) const;
+    void expand(Tree& tree, uint32_t node);
+    Player playout(Tree& tree);
+    void reroot(Tree& tree, uint32_t newRoot);
+    void clearTree(Tree& tree);
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const string& path) {
+    close();
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE map = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(handle, &fileSize) && fileSize.QuadPart > 0) {
+        map = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (map) view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!view) {
+        if (map) CloseHandle(map);
+        CloseHandle(handle);
+        return false;
+    }
+
+    file = handle;
+    mapping = map;
+    bytes = static_cast<const uint8_t*>(view);
+    length = size_t(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mapping) CloseHandle(HANDLE(mapping));
+    if (file) CloseHandle(HANDLE(file));
+    bytes = nullptr;
+    mapping = file = nullptr;
+    length = 0;
+}
+
+#else
+
+bool MappedFile::open(const string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); // o mapeamento continua válido sem o descritor
+    if (view == MAP_FAILED) return false;
+
+    bytes = static_cast<const uint8_t*>(view);
+    length = size_t(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) munmap(const_cast<uint8_t*>(bytes), length);
+    bytes = nullptr;
+    length = 0;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+/*
+ * @class MappedFile
+ * @brief Arquivo mapeado na memória, somente leitura
+ *
+ * Abrir não lê nada: as páginas são carregadas pelo sistema na primeira vez
+ * que são acessadas e ficam no cache de páginas, compartilhadas entre todos os
+ * processos que mapeiam o mesmo arquivo.
+ */
+class MappedFile {
+public:
+    MappedFile() {}
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& path);
+    void close();
+
+    bool isOpen() const { return bytes != nullptr; }
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* file = nullptr;       // HANDLE do arquivo e do mapeamento
+    void* mapping = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "Bitboard.h"
+#include <array>
+#include <cstdint>
+using namespace std;
+
+/*
+ * @class Position
+ * @brief Tabuleiro com jogar/desfazer no lugar, usado pela busca e pela interface
+ *
+ * Em vez de copiar o tabuleiro a cada jogada, makeMove altera a posição e
+ * empilha o necessário para unmakeMove voltar atrás. Junto com o tabuleiro
+ * são mantidos de forma incremental:
+ * - o hash Zobrist da posição
+ * - quantas peças de cada jogador há em cada linha vencedora
+ * - a avaliação heurística (soma das linhas abertas)
+ * - o vencedor, conferindo só as linhas que passam pela última casa jogada
+ *
+ * A pilha tem capacidade fixa de CELLS jogadas (cada jogada ocupa uma casa),
+ * então nada é alocado durante a busca.
+ */
+template <int Rows, int Cols, int K>
+class Position {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr int NUM_LINES = Board::NUM_LINES;
+
+    /*
+     * @struct UndoEntry
+     * @brief O que makeMove precisa guardar para unmakeMove desfazer a jogada
+     */
+    struct UndoEntry {
+        uint64_t previousHash;  // Hash antes da jogada
+        int previousScore;      // Avaliação antes da jogada
+        Player previousWinner;  // Vencedor antes da jogada
+        Player previousToMove;  // Jogador da vez antes da jogada (pode ser testada fora de vez)
+        uint16_t cell;          // Casa jogada
+        Player player;          // Quem jogou
+    };
+
+    // Chaves Zobrist por jogador e casa, geradas em tempo de compilação (splitmix64)
+    static constexpr array<array<uint64_t, CELLS>, 2> makeZobrist() {
+        array<array<uint64_t, CELLS>, 2> keys{};
+        uint64_t state = 0x9E3779B97F4A7C15ull ^ (uint64_t(Rows) << 32) ^ (uint64_t(Cols) << 16) ^ uint64_t(K);
+        for (auto& side : keys) {
+            for (uint64_t& key : side) {
+                state += 0x9E3779B97F4A7C15ull;
+                uint64_t z = state;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                key = z ^ (z >> 31);
+            }
+        }
+        return keys;
+    }
+    static constexpr array<array<uint64_t, CELLS>, 2> ZOBRIST = makeZobrist();
+
+    // Peso de uma linha aberta com n peças: cada peça a mais vale 4 vezes mais
+    static constexpr int lineWeight(int count) { return count == 0 ? 0 : 1 << (2 * (count - 1)); }
+
+    Position() { reset(); }
+
+    // Monta a posição a partir de um tabuleiro; a pilha de desfazer começa vazia
+    explicit Position(const Board& board) {
+        reset();
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (testBit(board.x, cell)) place(cell, Player::X);
+            else if (testBit(board.o, cell)) place(cell, Player::O);
+        }
+        toMove = playerToMove(board);
+    }
+
+    void reset() {
+        board = Board();
+        hash = 0;
+        score = 0;
+        winner = Player::NONE;
+        toMove = Player::X;
+        undoSize = 0;
+        for (auto& side : lineCount) side.fill(0);
+    }
+
+    /*
+     * @brief Joga na casa (que precisa estar vazia) e empilha a jogada
+     */
+    void makeMove(int cell, Player player) {
+        undoStack[undoSize++] = UndoEntry{ hash, score, winner, toMove, uint16_t(cell), player };
+        place(cell, player);
+        toMove = (player == Player::X) ? Player::O : Player::X;
+    }
+
+    /*
+     * @brief Desfaz a última jogada de makeMove
+     */
+    void unmakeMove() {
+        const UndoEntry& entry = undoStack[--undoSize];
+        const int side = (entry.player == Player::X) ? 0 : 1;
+
+        typename Board::Mask& stones = (side == 0) ? board.x : board.o;
+        stones &= typename Board::Mask(~cellBit<typename Board::Mask>(entry.cell));
+        for (int i = 0; i < Board::LINES_PER_CELL[entry.cell]; ++i) {
+            --lineCount[side][Board::CELL_LINES[entry.cell][i]];
+        }
+
+        hash = entry.previousHash;
+        score = entry.previousScore;
+        winner = entry.previousWinner;
+        toMove = entry.previousToMove;
+    }
+
+    const Board& getBoard() const { return board; }
+    uint64_t getHash() const { return hash; }
+    Player getWinner() const { return winner; }
+    Player sideToMove() const { return toMove; }
+    bool isGameOver() const { return winner != Player::NONE || board.isFull(); }
+    int getPly() const { return undoSize; } // jogadas feitas desde a posição base
+    int lastMove() const { return undoSize ? undoStack[undoSize - 1].cell : -1; }
+
+    // Avaliação heurística do ponto de vista de player
+    int getScore(Player player) const { return player == Player::X ? score : -score; }
+
+private:
+    Board board;
+    uint64_t hash;                  // Zobrist da posição
+    int score;                      // Avaliação incremental do ponto de vista de X
+    Player winner;                  // Quem completou K em linha (NONE se ninguém)
+    Player toMove;                  // Jogador da vez
+    array<array<uint8_t, NUM_LINES>, 2> lineCount; // Peças de X e de O em cada linha
+    array<UndoEntry, CELLS> undoStack;
+    int undoSize;
+
+    // Contribuição de uma linha para a avaliação: só linhas de um único dono contam
+    static constexpr array<array<int, K + 1>, K + 1> makeLineValues() {
+        array<array<int, K + 1>, K + 1> values{};
+        for (int countX = 0; countX <= K; ++countX) {
+            for (int countO = 0; countO <= K; ++countO) {
+                if (countO == 0) values[countX][countO] = lineWeight(countX);
+                else if (countX == 0) values[countX][countO] = -lineWeight(countO);
+            }
+        }
+        return values;
+    }
+    static constexpr array<array<int, K + 1>, K + 1> LINE_VALUES = makeLineValues();
+
+    // Coloca a peça e atualiza hash, contadores, avaliação e vencedor
+    void place(int cell, Player player) {
+        const int side = (player == Player::X) ? 0 : 1;
+        ((side == 0) ? board.x : board.o) |= cellBit<typename Board::Mask>(cell);
+        hash ^= ZOBRIST[side][cell];
+
+        for (int i = 0; i < Board::LINES_PER_CELL[cell]; ++i) {
+            const int line = Board::CELL_LINES[cell][i];
+            score -= LINE_VALUES[lineCount[0][line]][lineCount[1][line]];
+            if (++lineCount[side][line] == K) winner = player;
+            score += LINE_VALUES[lineCount[0][line]][lineCount[1][line]];
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "PositionBook.h"
+#include <cstring>
+using namespace std;
+
+namespace book {
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+uint64_t layerStart(int cells, int ply) {
+    uint64_t start = 0;
+    for (int p = 0; p < ply; ++p) start += endgame::layerSize(cells, p);
+    return start;
+}
+
+string bookPath(const string& directory, int rows, int cols, int k) {
+    return directory + "/" + to_string(rows) + "x" + to_string(cols) + "k" + to_string(k) + ".book";
+}
+
+}
+
+template <int Rows, int Cols, int K>
+bool PositionBook<Rows, Cols, K>::open(const string& path) {
+    close();
+    if (!file.open(path) || file.size() < sizeof(book::BookHeader)) {
+        close();
+        return false;
+    }
+
+    book::BookHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    uint64_t count = book::layerStart(CELLS, CELLS + 1);
+    if (header.magic != book::MAGIC || header.version != book::VERSION ||
+        header.rows != Rows || header.cols != Cols || header.k != K || header.moveBytes != MOVE_BYTES ||
+        header.count != count || header.movesOffset < sizeof(header) + count ||
+        file.size() != header.movesOffset + count * MOVE_BYTES) {
+        close();
+        return false;
+    }
+
+    values = file.data() + sizeof(header);
+    moves = file.data() + header.movesOffset;
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+void PositionBook<Rows, Cols, K>::close() {
+    file.close();
+    values = moves = nullptr;
+}
+
+template <int Rows, int Cols, int K>
+bool PositionBook<Rows, Cols, K>::verify() const {
+    if (!isOpen()) return false;
+    book::BookHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    return book::checksum(file.data() + sizeof(header), file.size() - sizeof(header)) == header.checksum;
+}
+
+template <int Rows, int Cols, int K>
+bool PositionBook<Rows, Cols, K>::indexOf(const Board& board, uint64_t& index) const {
+    uint32_t x = uint32_t(board.x), o = uint32_t(board.o);
+    int ply = __builtin_popcount(x | o);
+    if (!isOpen() || __builtin_popcount(x) != (ply + 1) / 2) return false;
+    index = book::layerStart(CELLS, ply) + endgame::positionIndex(x, o);
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+uint8_t PositionBook<Rows, Cols, K>::probe(const Board& board) const {
+    uint64_t index;
+    return indexOf(board, index) ? values[index] : uint8_t(endgame::INVALID);
+}
+
+template <int Rows, int Cols, int K>
+typename BitBoard<Rows, Cols, K>::Mask PositionBook<Rows, Cols, K>::bestMoves(const Board& board) const {
+    uint64_t index;
+    if (!indexOf(board, index)) return 0;
+    const uint8_t* entry = moves + index * MOVE_BYTES;
+    uint32_t mask = 0;
+    for (int b = 0; b < MOVE_BYTES; ++b) mask |= uint32_t(entry[b]) << (8 * b);
+    return typename Board::Mask(mask);
+}
+
+// Tabuleiros que cabem no banco de finais
+template class PositionBook<3, 3, 3>;
+template class PositionBook<4, 4, 3>;
+template class PositionBook<4, 4, 4>;
+template class PositionBook<5, 5, 4>;
@@ -0,0 +1,74 @@
+#ifndef POSITIONBOOK_H
+#define POSITIONBOOK_H
+
+#include "EndgameDatabase.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+using namespace std;
+
+/*
+ * @brief Formato do livro de posições (um arquivo por tabuleiro)
+ *
+ * Cabeçalho, depois o byte de valor de cada posição (mesma codificação do
+ * banco de finais) e, a partir de movesOffset, a máscara das jogadas ótimas
+ * em moveBytes bytes little-endian. As posições ficam na ordem das camadas
+ * do banco de finais: camada 0, camada 1, ... e dentro de cada camada pelo
+ * índice de endgame::positionIndex, sem lacunas.
+ */
+namespace book {
+
+constexpr uint32_t MAGIC = 0x42445643;  // "CVDB"
+constexpr uint32_t VERSION = 1;
+
+struct BookHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t rows, cols, k, moveBytes;
+    uint32_t reserved;
+    uint64_t count;         // Posições no livro
+    uint64_t movesOffset;   // Início das máscaras de jogadas (alinhado em 8)
+    uint64_t checksum;      // FNV-1a de 64 bits de tudo após o cabeçalho
+};
+
+uint64_t checksum(const uint8_t* data, size_t size);
+uint64_t layerStart(int cells, int ply);    // Posições de todas as camadas anteriores
+string bookPath(const string& directory, int rows, int cols, int k);
+
+}
+
+/*
+ * @class PositionBook
+ * @brief Livro de posições resolvidas, mapeado na memória somente leitura
+ *
+ * Abrir só confere o cabeçalho e o tamanho do arquivo; consultas são um
+ * cálculo de índice e uma leitura na memória mapeada. O tempo de abertura não
+ * depende do tamanho do livro e todas as IAs (e processos) que usam o mesmo
+ * arquivo dividem as mesmas páginas. O checksum é conferido por verify(), que
+ * lê o arquivo inteiro e por isso fica fora da abertura.
+ */
+template <int Rows, int Cols, int K>
+class PositionBook {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr bool SUPPORTED = CELLS <= endgame::MAX_CELLS;
+    static constexpr int MOVE_BYTES = CELLS <= 16 ? 2 : 4;
+
+    bool open(const string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    bool verify() const; // recalcula o checksum
+
+    uint8_t probe(const Board& board) const; // byte codificado; INVALID se não houver
+    typename Board::Mask bestMoves(const Board& board) const; // zero em posições encerradas
+
+private:
+    MappedFile file;
+    const uint8_t* values = nullptr;
+    const uint8_t* moves = nullptr;
+
+    bool indexOf(const Board& board, uint64_t& index) const;
+};
+
+#endif
@@ -0,0 +1,300 @@
+#include "RetrogradeSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+using namespace std;
+
+namespace {
+
+constexpr uint64_t POSITIONS_PER_TASK = 1u << 18;
+constexpr int TASKS_PER_THREAD = 4;     // Tarefas por thread em cada lote gravado
+
+// Próximo subconjunto com o mesmo número de bits (truque de Gosper)
+uint64_t nextSubset(uint64_t v) {
+    uint64_t t = v | (v - 1);
+    return (t + 1) | (((~t & (t + 1)) - 1) >> (__builtin_ctzll(v) + 1));
+}
+
+// Subconjunto de k bits com o índice colexicográfico dado
+uint64_t unrankSubset(uint64_t rank, int k, int cells) {
+    uint64_t mask = 0;
+    int b = cells - 1;
+    for (int i = k; i > 0; --i) {
+        while (endgame::binomial(b, i) > rank) --b;
+        mask |= uint64_t(1) << b;
+        rank -= endgame::binomial(b, i);
+        --b;
+    }
+    return mask;
+}
+
+}
+
+template <int Rows, int Cols, int K>
+RetrogradeSolver<Rows, Cols, K>::RetrogradeSolver(int threads) {
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    pool = make_unique<ThreadPool>(threads);
+}
+
+template <int Rows, int Cols, int K>
+bool RetrogradeSolver<Rows, Cols, K>::solve(const string& directory, const string& bookPath) {
+    stats.clear();
+    nextLayer.clear();
+
+    string temporaryBook = bookPath + ".tmp";
+    if (!bookPath.empty()) {
+        // Cabeçalho zerado até o fim: livro incompleto nunca é aceito por PositionBook
+        uint64_t count = book::layerStart(CELLS, CELLS + 1);
+        bookMovesOffset = (sizeof(book::BookHeader) + count + 7) / 8 * 8;
+        book::BookHeader header{};
+        book.open(temporaryBook, ios::in | ios::out | ios::binary | ios::trunc);
+        book.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!book) {
+            if (verbose) cout << "Erro ao criar " << temporaryBook << endl;
+            book.close();
+            return false;
+        }
+    }
+
+    for (int ply = CELLS; ply >= 0; --ply) {
+        LayerStats layerStats;
+        if (!solveLayer(directory, ply, layerStats)) {
+            if (verbose) cout << "Erro ao gravar " << endgame::layerPath(directory, Rows, Cols, K, ply) << endl;
+            if (book.is_open()) book.close();
+            return false;
+        }
+        stats.push_back(layerStats);
+
+        if (verbose) {
+            cout << "Camada " << setw(2) << ply << ": " << setw(12) << layerStats.positions << " posições | "
+                 << "vitórias " << layerStats.wins << ", empates " << layerStats.draws
+                 << ", derrotas " << layerStats.losses << " | "
+                 << (layerStats.reused ? string("já existia") : to_string(layerStats.seconds) + " s") << endl;
+        }
+    }
+    nextLayer.clear();
+    nextLayer.shrink_to_fit();
+
+    if (book.is_open() && !finishBook(temporaryBook, bookPath)) {
+        if (verbose) cout << "Erro ao gravar " << bookPath << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * @brief Calcula o checksum do livro já completo, grava o cabeçalho por
+ * último e só então troca o arquivo temporário pelo definitivo
+ */
+template <int Rows, int Cols, int K>
+bool RetrogradeSolver<Rows, Cols, K>::finishBook(const string& temporary, const string& bookPath) {
+    book.close();
+    if (book.fail()) return false;
+
+    book::BookHeader header{ book::MAGIC, book::VERSION, uint8_t(Rows), uint8_t(Cols), uint8_t(K),
+                             uint8_t(PositionBook<Rows, Cols, K>::MOVE_BYTES), 0,
+                             book::layerStart(CELLS, CELLS + 1), bookMovesOffset, 0 };
+    {
+        MappedFile mapped;
+        if (!mapped.open(temporary) || mapped.size() < sizeof(header)) return false;
+        header.checksum = book::checksum(mapped.data() + sizeof(header), mapped.size() - sizeof(header));
+    }
+
+    fstream out(temporary, ios::in | ios::out | ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (out.fail()) return false;
+
+    remove(bookPath.c_str());
+    if (rename(temporary.c_str(), bookPath.c_str()) != 0) return false;
+    if (verbose) cout << "Livro de posições: " << bookPath << endl;
+    return true;
+}
+
+/*
+ * @brief Resolve a camada ply em lotes e grava no disco; depois ela passa a
+ * ser a camada consultada pela próxima (ply - 1)
+ */
+template <int Rows, int Cols, int K>
+bool RetrogradeSolver<Rows, Cols, K>::solveLayer(const string& directory, int ply, LayerStats& layerStats) {
+    constexpr int MOVE_BYTES = PositionBook<Rows, Cols, K>::MOVE_BYTES;
+    auto start = chrono::steady_clock::now();
+    string path = endgame::layerPath(directory, Rows, Cols, K, ply);
+    string temporary = path + ".tmp";
+    layerStats.ply = ply;
+    layerStats.positions = endgame::layerSize(CELLS, ply);
+    layerStats.reused = loadLayer(path, ply, nullptr);
+
+    // O livro precisa das jogadas ótimas, que não ficam nos arquivos de camada
+    if (!layerStats.reused || book.is_open()) {
+        ofstream out;
+        if (!layerStats.reused) {
+            // Grava num arquivo temporário: camada pela metade nunca parece válida
+            out.open(temporary, ios::binary);
+            endgame::LayerHeader header{ endgame::MAGIC, endgame::VERSION, uint8_t(Rows), uint8_t(Cols),
+                                         uint8_t(K), uint8_t(ply), 0, layerStats.positions };
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        uint64_t occupiedTotal = endgame::binomial(CELLS, ply);
+        uint64_t perOccupied = endgame::binomial(ply, (ply + 1) / 2);
+        uint64_t occupiedPerTask = max<uint64_t>(1, POSITIONS_PER_TASK / perOccupied);
+        uint64_t occupiedPerBatch = occupiedPerTask * uint64_t(pool->size() * TASKS_PER_THREAD);
+        uint64_t bookLayer = book::layerStart(CELLS, ply);
+        vector<uint8_t> batch;
+        vector<uint32_t> batchMoves;
+        vector<uint8_t> moveBytes;
+
+        for (uint64_t batchStart = 0; batchStart < occupiedTotal; batchStart += occupiedPerBatch) {
+            uint64_t batchEnd = min(occupiedTotal, batchStart + occupiedPerBatch);
+            batch.resize((batchEnd - batchStart) * perOccupied);
+            if (book.is_open()) batchMoves.resize(batch.size());
+            for (uint64_t first = batchStart; first < batchEnd; first += occupiedPerTask) {
+                uint64_t count = min(occupiedPerTask, batchEnd - first);
+                uint64_t offset = (first - batchStart) * perOccupied;
+                uint8_t* target = batch.data() + offset;
+                uint32_t* moves = book.is_open() ? batchMoves.data() + offset : nullptr;
+                pool->submit([this, ply, first, count, target, moves](int) {
+                    solveRange(ply, first, count, target, moves);
+                });
+            }
+            pool->wait();
+
+            if (out.is_open()) out.write(reinterpret_cast<const char*>(batch.data()), streamsize(batch.size()));
+            if (book.is_open()) {
+                // Máscaras em little-endian, com a largura fixa do formato
+                moveBytes.resize(batchMoves.size() * MOVE_BYTES);
+                for (size_t i = 0; i < batchMoves.size(); ++i) {
+                    for (int b = 0; b < MOVE_BYTES; ++b) moveBytes[i * MOVE_BYTES + b] = uint8_t(batchMoves[i] >> (8 * b));
+                }
+                uint64_t position = bookLayer + batchStart * perOccupied;
+                book.seekp(streamoff(sizeof(book::BookHeader) + position));
+                book.write(reinterpret_cast<const char*>(batch.data()), streamsize(batch.size()));
+                book.seekp(streamoff(bookMovesOffset + position * MOVE_BYTES));
+                book.write(reinterpret_cast<const char*>(moveBytes.data()), streamsize(moveBytes.size()));
+            }
+            if ((out.is_open() && !out) || (book.is_open() && !book)) return false;
+        }
+
+        if (out.is_open()) {
+            out.close();
+            if (!out) return false;
+            remove(path.c_str());
+            if (rename(temporary.c_str(), path.c_str()) != 0) return false;
+        }
+    }
+
+    if (!loadLayer(path, ply, &nextLayer)) return false;
+    for (uint8_t value : nextLayer) {
+        switch (endgame::resultOf(value)) {
+            case endgame::WIN: ++layerStats.wins; break;
+            case endgame::DRAW: ++layerStats.draws; break;
+            case endgame::LOSS: ++layerStats.losses; break;
+            default: break;
+        }
+    }
+    layerStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+/*
+ * @brief Confere o cabeçalho e o tamanho do arquivo; com values, lê a camada inteira
+ */
+template <int Rows, int Cols, int K>
+bool RetrogradeSolver<Rows, Cols, K>::loadLayer(const string& path, int ply, vector<uint8_t>* values) {
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) return false;
+    uint64_t count = endgame::layerSize(CELLS, ply);
+    if (uint64_t(in.tellg()) != sizeof(endgame::LayerHeader) + count) return false;
+
+    endgame::LayerHeader header{};
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != endgame::MAGIC || header.version != endgame::VERSION ||
+        header.rows != Rows || header.cols != Cols || header.k != K || header.ply != ply ||
+        header.count != count) {
+        return false;
+    }
+    if (!values) return true;
+
+    values->clear();
+    values->shrink_to_fit(); // libera a camada anterior antes de alocar a nova
+    values->resize(count);
+    return bool(in.read(reinterpret_cast<char*>(values->data()), streamsize(count)));
+}
+
+/*
+ * @brief Resolve occupiedCount conjuntos de casas ocupadas seguidos, a partir
+ * do índice firstOccupied; para cada um, todas as distribuições de X e O.
+ * Com moves, grava também a máscara das jogadas ótimas de cada posição
+ */
+template <int Rows, int Cols, int K>
+void RetrogradeSolver<Rows, Cols, K>::solveRange(int ply, uint64_t firstOccupied, uint64_t occupiedCount,
+                                                 uint8_t* out, uint32_t* moves) const {
+    int countX = (ply + 1) / 2;
+    uint64_t perOccupied = endgame::binomial(ply, countX);
+    uint64_t occupied = unrankSubset(firstOccupied, ply, CELLS);
+    int cells[CELLS];
+
+    for (uint64_t n = 0; n < occupiedCount; ++n) {
+        int j = 0;
+        for (uint64_t rest = occupied; rest != 0; rest &= rest - 1) cells[j++] = __builtin_ctzll(rest);
+
+        uint64_t xAmongOccupied = (uint64_t(1) << countX) - 1;
+        for (uint64_t s = 0; s < perOccupied; ++s) {
+            uint32_t x = 0;
+            for (uint64_t rest = xAmongOccupied; rest != 0; rest &= rest - 1) x |= 1u << cells[__builtin_ctzll(rest)];
+            uint32_t bestMoves;
+            *out++ = solvePosition(x, uint32_t(occupied) & ~x, ply, bestMoves);
+            if (moves) *moves++ = bestMoves;
+            if (s + 1 < perOccupied) xAmongOccupied = nextSubset(xAmongOccupied);
+        }
+        if (n + 1 < occupiedCount) occupied = nextSubset(occupied);
+    }
+}
+
+/*
+ * @brief Valor de uma posição a partir dos filhos na camada seguinte; vitórias
+ * preferem o menor caminho e derrotas o maior, como na tabela do 3x3
+ */
+template <int Rows, int Cols, int K>
+uint8_t RetrogradeSolver<Rows, Cols, K>::solvePosition(uint32_t x, uint32_t o, int ply, uint32_t& bestMoves) const {
+    using Mask = typename Board::Mask;
+    bestMoves = 0;
+    bool xToMove = (ply % 2 == 0);
+    bool moverLine = Board::hasLine(Mask(xToMove ? x : o));
+    bool lastLine = Board::hasLine(Mask(xToMove ? o : x));
+
+    // Quem joga não pode ter linha: a partida teria acabado antes
+    if (moverLine) return endgame::INVALID;
+    if (lastLine) return endgame::encode(endgame::LOSS, 0);
+    if (ply == CELLS) return endgame::encode(endgame::DRAW, 0);
+
+    int bestResult = -1, bestDistance = 0;
+    uint32_t empty = ~(x | o) & uint32_t(Board::FULL);
+    for (; empty != 0; empty &= empty - 1) {
+        uint32_t cell = empty & (~empty + 1);
+        uint8_t child = nextLayer[xToMove ? endgame::positionIndex(x | cell, o)
+                                          : endgame::positionIndex(x, o | cell)];
+        if (endgame::resultOf(child) == endgame::INVALID) continue;
+        int result = endgame::WIN + endgame::LOSS - endgame::resultOf(child);
+        int distance = endgame::distanceOf(child) + 1;
+        if (result > bestResult ||
+            (result == bestResult && (result == endgame::WIN ? distance < bestDistance : distance > bestDistance))) {
+            bestResult = result;
+            bestDistance = distance;
+            bestMoves = 0;
+        }
+        if (result == bestResult && distance == bestDistance) bestMoves |= cell;
+    }
+    return endgame::encode(endgame::Result(bestResult), bestDistance);
+}
+
+// Tabuleiros que cabem no banco de finais
+template class RetrogradeSolver<3, 3, 3>;
+template class RetrogradeSolver<4, 4, 3>;
+template class RetrogradeSolver<4, 4, 4>;
+template class RetrogradeSolver<5, 5, 4>;
@@ -0,0 +1,73 @@
+#ifndef RETROGRADESOLVER_H
+#define RETROGRADESOLVER_H
+
+#include "EndgameDatabase.h"
+#include "PositionBook.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * @struct LayerStats
+ * @brief Resumo de uma camada resolvida
+ */
+struct LayerStats {
+    int ply = 0;
+    uint64_t positions = 0;     // Posições na camada (inclui as impossíveis)
+    uint64_t wins = 0;          // Do ponto de vista de quem joga
+    uint64_t draws = 0;
+    uint64_t losses = 0;
+    double seconds = 0.0;
+    bool reused = false;        // Arquivo já existia e foi aproveitado
+};
+
+/*
+ * @class RetrogradeSolver
+ * @brief Resolve todas as posições de um tabuleiro pequeno por análise retrógrada
+ *
+ * As posições são agrupadas em camadas pelo número de peças. Uma jogada
+ * sempre leva da camada p para a p + 1, então as camadas são resolvidas do
+ * tabuleiro cheio até o vazio, cada uma consultando só a seguinte.
+ *
+ * - Cada posição tem um índice exato na camada (casas ocupadas e quais são X,
+ *   na ordem colexicográfica): o arquivo é um byte por posição, sem chaves
+ * - Na memória ficam apenas a camada seguinte e um lote da camada atual; o
+ *   lote é gravado no disco assim que as threads terminam
+ * - As faixas de índices de um lote são divididas entre as threads do pool
+ * - Camadas já gravadas (cabeçalho válido) são reaproveitadas, então uma
+ *   geração interrompida continua de onde parou
+ * - Opcionalmente grava também o livro de posições (PositionBook), com as
+ *   jogadas ótimas de cada posição; nesse caso toda camada é recalculada
+ */
+template <int Rows, int Cols, int K>
+class RetrogradeSolver {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static_assert(CELLS <= endgame::MAX_CELLS, "análise retrógrada só para tabuleiros pequenos");
+
+    explicit RetrogradeSolver(int threads); // 0 = um por núcleo
+
+    // grava as CELLS + 1 camadas no diretório e, se bookPath não for vazio, o livro
+    bool solve(const string& directory, const string& bookPath = "");
+    const vector<LayerStats>& getStats() const { return stats; }
+    void setVerbose(bool enabled) { verbose = enabled; }
+
+private:
+    unique_ptr<ThreadPool> pool;
+    vector<uint8_t> nextLayer;  // Camada ply + 1, já resolvida
+    vector<LayerStats> stats;
+    bool verbose = true;
+    fstream book;               // Livro em construção (fechado se não foi pedido)
+    uint64_t bookMovesOffset = 0;
+
+    bool solveLayer(const string& directory, int ply, LayerStats& layerStats);
+    bool loadLayer(const string& path, int ply, vector<uint8_t>* values);
+    bool finishBook(const string& temporary, const string& bookPath);
+    void solveRange(int ply, uint64_t firstOccupied, uint64_t occupiedCount, uint8_t* out, uint32_t* moves) const;
+    uint8_t solvePosition(uint32_t x, uint32_t o, int ply, uint32_t& bestMoves) const;
+};
+
+#endif
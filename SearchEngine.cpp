@@ -0,0 +1,366 @@
+#include "SearchEngine.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+using namespace std;
+
+namespace {
+
+const int INFINITE_SCORE = 1 << 30;
+
+// Entradas da tabela de transposição (16 bytes cada): 1 MB no 3x3/4x4, 16 MB nos maiores
+const size_t TABLE_ENTRIES_SMALL = size_t(1) << 16;
+const size_t TABLE_ENTRIES_LARGE = size_t(1) << 20;
+
+// Vitórias são gravadas na tabela relativas ao nó, não à raiz, para valerem
+// em qualquer profundidade em que a posição reaparecer
+const int MATE_THRESHOLD = (1 << 23);
+
+inline int toTable(int score, int ply) {
+    if (score > MATE_THRESHOLD) return score + ply;
+    if (score < -MATE_THRESHOLD) return score - ply;
+    return score;
+}
+
+inline int fromTable(int score, int ply) {
+    if (score > MATE_THRESHOLD) return score - ply;
+    if (score < -MATE_THRESHOLD) return score + ply;
+    return score;
+}
+
+inline int playerIndex(Player player) {
+    return player == Player::X ? 0 : 1;
+}
+
+}
+
+template <int Rows, int Cols, int K>
+SearchEngine<Rows, Cols, K>::SearchEngine() : stopped(false), stopRequested(false), sharedNodes(0), rootBestCell(-1) {
+    prepareWorkers(1);
+}
+
+template <int Rows, int Cols, int K>
+SearchEngine<Rows, Cols, K>::~SearchEngine() {
+}
+
+template <int Rows, int Cols, int K>
+const SearchStats& SearchEngine<Rows, Cols, K>::getStats() const {
+    return stats;
+}
+
+template <int Rows, int Cols, int K>
+size_t SearchEngine<Rows, Cols, K>::memoryBytes() const {
+    return (table ? table->memoryBytes() : 0) + workers.size() * sizeof(Worker);
+}
+
+template <int Rows, int Cols, int K>
+void SearchEngine<Rows, Cols, K>::clearHistory() {
+    for (auto& worker : workers) {
+        for (auto& row : worker->history) {
+            fill(begin(row), end(row), 0);
+        }
+    }
+}
+
+template <int Rows, int Cols, int K>
+void SearchEngine<Rows, Cols, K>::prepare() {
+    stopRequested = false;
+}
+
+template <int Rows, int Cols, int K>
+void SearchEngine<Rows, Cols, K>::stop() {
+    stopRequested = true;
+    stopped = true;
+}
+
+template <int Rows, int Cols, int K>
+void SearchEngine<Rows, Cols, K>::prepareWorkers(int count) {
+    while (int(workers.size()) < count) {
+        workers.push_back(make_unique<Worker>());
+        for (auto& row : workers.back()->history) {
+            fill(begin(row), end(row), 0);
+        }
+    }
+}
+
+/*
+ * @brief Aprofundamento iterativo: cada iteração concluída atualiza a melhor jogada
+ */
+template <int Rows, int Cols, int K>
+int SearchEngine<Rows, Cols, K>::search(const Board& board, const SearchLimits& searchLimits) {
+    auto start = chrono::steady_clock::now();
+    stats = SearchStats();
+    limits = searchLimits;
+    if (limits.threads < 1) limits.threads = 1;
+    deadline = start + limits.timeBudget;
+    // Zera antes de ler o pedido: um stop() concorrente deixa um dos dois ligado
+    stopped = false;
+    if (stopRequested) stopped = true;
+    sharedNodes = 0;
+    rootBestCell = -1;
+
+    typename Board::Mask empty = board.emptyCells();
+    if (!anyBit(empty) || board.winner() != Player::NONE) {
+        return -1;
+    }
+
+    if (!table) {
+        table = make_unique<TranspositionTable>(CELLS <= 16 ? TABLE_ENTRIES_SMALL : TABLE_ENTRIES_LARGE);
+    }
+
+    // Busca paralela: a thread que chama usa workers[0] e cada thread do pool o seu
+    int used = 1;
+    if (limits.threads > 1) {
+        used = limits.threads + 1;
+        if (!pool || pool->size() != limits.threads) {
+            pool = make_unique<ThreadPool>(limits.threads);
+        }
+    }
+    prepareWorkers(used);
+
+    // Envelhece o histórico da busca anterior para favorecer informação recente
+    for (int i = 0; i < used; ++i) {
+        Worker& worker = *workers[i];
+        worker.position = Pos(board);
+        worker.stats = SearchStats();
+        for (auto& row : worker.history) {
+            for (int& value : row) value /= 2;
+        }
+    }
+
+    Player toMove = playerToMove(board);
+    int maxDepth = min(limits.maxDepth, bitCount(empty));
+    if (maxDepth < 1) maxDepth = 1;
+
+    // Se nem a primeira iteração terminar, fica a primeira jogada da ordenação
+    uint16_t moves[CELLS];
+    orderMoves(*workers[0], toMove, -1, moves);
+    int bestCell = moves[0];
+
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        int cell = -1;
+        int score = searchRoot(depth, cell);
+        if (stopped) {
+            stats.aborted = true;
+            break;
+        }
+
+        bestCell = cell;
+        rootBestCell = cell;
+        stats.depthReached = depth;
+        stats.bestScore = score;
+
+        // Resultado forçado dentro do horizonte: buscar mais fundo não muda a escolha.
+        // (Um resultado mais distante pode ter vindo da tabela de uma busca anterior
+        // e ainda haver vitória mais rápida a ser encontrada.)
+        if (abs(score) >= WIN_SCORE - depth) break;
+    }
+
+    for (int i = 0; i < used; ++i) {
+        stats.nodes += workers[i]->stats.nodes;
+        stats.cutoffs += workers[i]->stats.cutoffs;
+        stats.researches += workers[i]->stats.researches;
+        stats.ttProbes += workers[i]->stats.ttProbes;
+        stats.ttHits += workers[i]->stats.ttHits;
+    }
+    stats.elapsedMicros = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - start).count();
+    return bestCell;
+}
+
+/*
+ * @brief Uma iteração na raiz: sequencial com uma thread, dividida entre as
+ * threads do pool com mais de uma
+ */
+template <int Rows, int Cols, int K>
+int SearchEngine<Rows, Cols, K>::searchRoot(int depth, int& bestCell) {
+    Worker& main = *workers[0];
+    if (limits.threads <= 1) {
+        return pvs(main, depth, 0, -INFINITE_SCORE, INFINITE_SCORE, &bestCell);
+    }
+
+    ++main.stats.nodes;
+    uint16_t moves[CELLS];
+    int count = orderMoves(main, main.position.sideToMove(), rootBestCell, moves);
+    return searchRootParallel(depth, moves, count, bestCell);
+}
+
+/*
+ * @brief Divisão na raiz: a primeira jogada (a mais promissora) é buscada com
+ * janela cheia e dá o alfa inicial; as demais viram tarefas com janela nula
+ * contra o melhor valor já conhecido, rebuscadas só quando o superam
+ */
+template <int Rows, int Cols, int K>
+int SearchEngine<Rows, Cols, K>::searchRootParallel(int depth, const uint16_t* moves, int count, int& bestCell) {
+    Worker& main = *workers[0];
+    Player toMove = main.position.sideToMove();
+
+    main.position.makeMove(moves[0], toMove);
+    int best = -pvs(main, depth - 1, 1, -INFINITE_SCORE, INFINITE_SCORE, nullptr);
+    main.position.unmakeMove();
+    bestCell = moves[0];
+    if (stopped) return best;
+
+    atomic<int> alpha(best);
+    mutex resultLock;
+    for (int i = 1; i < count; ++i) {
+        int cell = moves[i];
+        pool->submit([this, cell, depth, toMove, &alpha, &best, &bestCell, &resultLock](int thread) {
+            if (stopped) return;
+            Worker& worker = *workers[thread + 1];
+
+            worker.position.makeMove(cell, toMove);
+            int a = alpha.load();
+            int score = -pvs(worker, depth - 1, 1, -a - 1, -a, nullptr);
+            if (score > a && !stopped) {
+                ++worker.stats.researches;
+                score = -pvs(worker, depth - 1, 1, -INFINITE_SCORE, -a, nullptr);
+            }
+            worker.position.unmakeMove();
+            if (stopped) return;
+
+            lock_guard<mutex> guard(resultLock);
+            if (score > best) {
+                best = score;
+                bestCell = cell;
+                if (score > alpha.load()) alpha.store(score);
+            }
+        });
+    }
+    pool->wait();
+    return best;
+}
+
+/*
+ * @brief Negamax alfa-beta com janela nula para os irmãos da variante principal
+ */
+template <int Rows, int Cols, int K>
+int SearchEngine<Rows, Cols, K>::pvs(Worker& worker, int depth, int ply, int alpha, int beta, int* bestCell) {
+    ++worker.stats.nodes;
+    if (outOfBudget(worker)) {
+        stopped = true;
+    }
+    if (stopped) return 0;
+
+    // Quem acabou de jogar venceu: derrota para o jogador da vez, mais cedo pesa mais
+    Pos& position = worker.position;
+    if (position.getWinner() != Player::NONE) {
+        return -(WIN_SCORE - ply);
+    }
+    if (position.getBoard().isFull()) return 0;
+
+    // Folha não terminal: linhas ainda abertas de cada lado, mantidas pela Position
+    Player toMove = position.sideToMove();
+    if (depth == 0) return position.getScore(toMove);
+
+    // Tabela de transposição: fora da raiz pode encerrar o nó; sempre sugere a jogada
+    int ttMove = -1;
+    TTEntry entry;
+    ++worker.stats.ttProbes;
+    if (table->probe(position.getHash(), entry)) {
+        ++worker.stats.ttHits;
+        ttMove = entry.move;
+        if (ply > 0 && entry.depth >= depth) {
+            int ttScore = fromTable(entry.score, ply);
+            if (entry.bound == Bound::EXACT) return ttScore;
+            if (entry.bound == Bound::LOWER && ttScore >= beta) return ttScore;
+            if (entry.bound == Bound::UPPER && ttScore <= alpha) return ttScore;
+        }
+    }
+
+    uint16_t moves[CELLS];
+    int count = orderMoves(worker, toMove, ply == 0 ? rootBestCell : ttMove, moves);
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    int bestMove = -1;
+
+    for (int i = 0; i < count; ++i) {
+        int cell = moves[i];
+        position.makeMove(cell, toMove);
+
+        int score;
+        if (i == 0) {
+            score = -pvs(worker, depth - 1, ply + 1, -beta, -alpha, nullptr);
+        } else {
+            score = -pvs(worker, depth - 1, ply + 1, -alpha - 1, -alpha, nullptr);
+            if (score > alpha && score < beta && !stopped) {
+                ++worker.stats.researches;
+                score = -pvs(worker, depth - 1, ply + 1, -beta, -alpha, nullptr);
+            }
+        }
+        position.unmakeMove();
+        if (stopped) return best;
+
+        if (score > best) {
+            best = score;
+            bestMove = cell;
+            if (bestCell) *bestCell = cell;
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) {
+            ++worker.stats.cutoffs;
+            worker.history[playerIndex(toMove)][cell] += depth * depth;
+            break;
+        }
+    }
+
+    Bound bound = (best <= originalAlpha) ? Bound::UPPER : (best >= beta) ? Bound::LOWER : Bound::EXACT;
+    table->store(position.getHash(), toTable(best, ply), depth, bound, bestMove);
+    return best;
+}
+
+/*
+ * @brief Ordena as casas candidatas: jogada principal, casas com mais linhas
+ * vencedoras e histórico
+ * @return quantidade de jogadas escritas em moves
+ */
+template <int Rows, int Cols, int K>
+int SearchEngine<Rows, Cols, K>::orderMoves(const Worker& worker, Player toMove, int pvCell, uint16_t* moves) const {
+    int keys[CELLS];
+    int count = 0;
+    const Board& board = worker.position.getBoard();
+    const int* hist = worker.history[playerIndex(toMove)];
+
+    typename Board::Mask candidates = board.candidateMoves();
+
+    while (anyBit(candidates)) {
+        int cell = lowestBit(candidates);
+        clearLowest(candidates);
+
+        int key = (cell == pvCell) ? INT32_MAX : Board::LINES_PER_CELL[cell] * (1 << 20) + hist[cell];
+
+        // Inserção ordenada: poucas casas candidatas por nó
+        int pos = count++;
+        while (pos > 0 && keys[pos - 1] < key) {
+            keys[pos] = keys[pos - 1];
+            moves[pos] = moves[pos - 1];
+            --pos;
+        }
+        keys[pos] = key;
+        moves[pos] = uint16_t(cell);
+    }
+    return count;
+}
+
+template <int Rows, int Cols, int K>
+bool SearchEngine<Rows, Cols, K>::outOfBudget(Worker& worker) {
+    const uint64_t nodes = worker.stats.nodes;
+    if ((nodes & 1023) != 0) {
+        // Uma thread: orçamento de nós exato, para a busca ser reprodutível
+        return limits.threads <= 1 && limits.maxNodes != 0 && nodes > limits.maxNodes;
+    }
+
+    // A cada 1024 nós: soma no contador global e consulta o relógio (caro)
+    uint64_t total = (limits.threads <= 1) ? nodes : (sharedNodes += 1024);
+    if (limits.maxNodes != 0 && total > limits.maxNodes) return true;
+    if (limits.timeBudget.count() > 0) {
+        return chrono::steady_clock::now() >= deadline;
+    }
+    return false;
+}
+
+// Tabuleiros suportados pelo jogo
+template class SearchEngine<3, 3, 3>;
+template class SearchEngine<4, 4, 4>;
+template class SearchEngine<5, 5, 4>;
+template class SearchEngine<15, 15, 5>;
@@ -0,0 +1,108 @@
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+
+#include "Position.h"
+#include "TranspositionTable.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+/*
+ * @struct SearchLimits
+ * @brief Limites de uma busca: profundidade, nós visitados e tempo por jogada
+ *
+ * Zero em maxNodes ou timeBudget significa "sem limite". Com threads == 1 a
+ * busca é sequencial e determinística (mesmas jogadas para o mesmo histórico
+ * de buscas, sem orçamento de tempo).
+ */
+struct SearchLimits {
+    int maxDepth = 64;                              // Profundidade máxima em jogadas
+    uint64_t maxNodes = 0;                          // Orçamento de nós
+    chrono::microseconds timeBudget{0};             // Prazo por jogada
+    int threads = 1;                                // Threads da busca (divisão na raiz)
+};
+
+/*
+ * @struct SearchStats
+ * @brief Estatísticas da última busca
+ */
+struct SearchStats {
+    uint64_t nodes = 0;         // Nós visitados
+    uint64_t cutoffs = 0;       // Cortes beta (alfa-beta)
+    uint64_t researches = 0;    // Rebuscas com janela cheia (PVS)
+    uint64_t ttProbes = 0;      // Consultas à tabela de transposição
+    uint64_t ttHits = 0;        // Consultas que encontraram a posição
+    int depthReached = 0;       // Última profundidade concluída
+    int bestScore = 0;          // Avaliação da melhor jogada
+    bool aborted = false;       // Indica se o orçamento acabou no meio de uma iteração
+    int64_t elapsedMicros = 0;  // Duração total da busca
+};
+
+/*
+ * @class SearchEngine
+ * @brief Busca alfa-beta (PVS) com aprofundamento iterativo
+ *
+ * - Ordenação de jogadas: jogada principal da iteração anterior, casas com
+ *   mais linhas vencedoras (centro, depois cantos no 3x3) e por fim a
+ *   heurística de histórico
+ * - Pontuação ciente da distância: vencer mais cedo vale mais
+ * - Respeita o orçamento de nós/tempo e devolve a melhor jogada já encontrada
+ * - Em tabuleiros grandes só considera casas vizinhas às peças já jogadas
+ * - Joga e desfaz no lugar (Position): nenhuma cópia de tabuleiro nem
+ *   alocação por nó; vencedor e avaliação são mantidos incrementalmente
+ * - Tabela de transposição sem travas, mantida entre as buscas
+ * - Com várias threads, a primeira jogada da raiz é buscada primeiro e as
+ *   demais viram tarefas em um pool com roubo de tarefas, todas com janela
+ *   nula contra o melhor valor já conhecido e a mesma tabela de transposição
+ */
+template <int Rows, int Cols, int K>
+class SearchEngine {
+public:
+    using Board = BitBoard<Rows, Cols, K>;
+    using Pos = Position<Rows, Cols, K>;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr int WIN_SCORE = 1 << 24; // Vitória na jogada p vale WIN_SCORE - p
+
+    SearchEngine();
+    ~SearchEngine();
+
+    int search(const Board& board, const SearchLimits& limits); // retorna a casa escolhida (-1 se não houver)
+    const SearchStats& getStats() const;
+    void clearHistory();
+    void prepare(); // antes de despachar a busca: esquece um stop() anterior
+    void stop(); // interrompe a busca em andamento ou a próxima (pode ser chamada de outra thread)
+    size_t memoryBytes() const; // tabela de transposição e estado das threads
+
+private:
+    // Estado próprio de cada thread: posição, histórico e contadores
+    struct Worker {
+        Pos position;
+        int history[2][CELLS];      // Heurística de histórico por jogador e casa
+        SearchStats stats;
+    };
+
+    vector<unique_ptr<Worker>> workers;     // [0] é a thread que chamou search
+    unique_ptr<TranspositionTable> table;   // Criada na primeira busca
+    unique_ptr<ThreadPool> pool;            // Criado na primeira busca paralela
+    SearchStats stats;
+    SearchLimits limits;
+    chrono::steady_clock::time_point deadline;
+    atomic<bool> stopped;           // Parada vista pelas threads: pedido ou orçamento esgotado
+    atomic<bool> stopRequested;     // stop() até o próximo prepare(); search não apaga
+    atomic<uint64_t> sharedNodes;   // Nós de todas as threads, somados em lotes
+    int rootBestCell;               // Jogada principal da última iteração concluída
+
+    int searchRoot(int depth, int& bestCell);
+    int searchRootParallel(int depth, const uint16_t* moves, int count, int& bestCell);
+    int pvs(Worker& worker, int depth, int ply, int alpha, int beta, int* bestCell);
+    int orderMoves(const Worker& worker, Player toMove, int pvCell, uint16_t* moves) const;
+    bool outOfBudget(Worker& worker);
+    void prepareWorkers(int count);
+};
+
+#endif
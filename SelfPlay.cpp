@@ -0,0 +1,140 @@
+#include "SelfPlay.h"
+#include "Position.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+using namespace std;
+
+namespace {
+
+// Mistura de bits (splitmix64) para derivar sementes independentes
+uint64_t mixSeed(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/*
+ * @brief Joga uma partida completa entre as duas IAs
+ * @return vencedor; em jogada inválida, vence o adversário de quem errou
+ */
+template <int Rows, int Cols, int K>
+Player playGame(AIPlayerBase& playerX, AIPlayerBase& playerO, bool& illegal) {
+    playerX.resetTree();
+    playerO.resetTree();
+
+    Position<Rows, Cols, K> position;
+    while (!position.isGameOver()) {
+        Player toMove = position.sideToMove();
+        pair<int, int> move = (toMove == Player::X ? playerX : playerO).getBestMove();
+
+        if (move.first < 0 || move.first >= Rows || move.second < 0 || move.second >= Cols ||
+            !position.getBoard().isEmpty(move.first, move.second)) {
+            illegal = true;
+            return toMove == Player::X ? Player::O : Player::X;
+        }
+
+        position.makeMove(BitBoard<Rows, Cols, K>::index(move.first, move.second), toMove);
+        playerX.updateTree(move);
+        playerO.updateTree(move);
+    }
+    return position.getWinner();
+}
+
+// Parte das partidas de um confronto jogada por uma thread
+template <int Rows, int Cols, int K>
+void playShare(const MatchConfig& config, const SelfPlayOptions& options, uint64_t games, uint64_t seed,
+               MatchResult& result) {
+    AIPlayer<Rows, Cols, K> playerX(Player::X, config.x, uint32_t(mixSeed(seed)));
+    AIPlayer<Rows, Cols, K> playerO(Player::O, config.o, uint32_t(mixSeed(seed ^ 0x5bd1e995u)));
+    playerX.setVerbose(false);
+    playerO.setVerbose(false);
+    playerX.setTelemetryEnabled(false);
+    playerO.setTelemetryEnabled(false);
+    if constexpr (!AIPlayer<Rows, Cols, K>::IS_CLASSIC) {
+        playerX.setSearchLimits(options.limits);
+        playerO.setSearchLimits(options.limits);
+        if (!options.endgameDirectory.empty()) {
+            if (!playerX.loadPositionBook(options.endgameDirectory)) playerX.loadEndgameDatabase(options.endgameDirectory);
+            if (!playerO.loadPositionBook(options.endgameDirectory)) playerO.loadEndgameDatabase(options.endgameDirectory);
+        }
+    }
+    playerX.setMCTSLimits(options.mctsLimits);
+    playerO.setMCTSLimits(options.mctsLimits);
+
+    for (uint64_t i = 0; i < games; ++i) {
+        bool illegal = false;
+        Player winner = playGame<Rows, Cols, K>(playerX, playerO, illegal);
+        if (illegal) ++result.illegalMoves;
+        if (winner == Player::X) ++result.xWins;
+        else if (winner == Player::O) ++result.oWins;
+        else ++result.draws;
+        ++result.games;
+    }
+}
+
+}
+
+SelfPlay::SelfPlay(const SelfPlayOptions& options) : options(options), matchCounter(0) {
+    threads = options.threads;
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+}
+
+MatchResult SelfPlay::play(const MatchConfig& config) {
+    auto start = chrono::steady_clock::now();
+    uint64_t matchSeed = mixSeed(options.seed + ++matchCounter);
+
+    // Divide as partidas igualmente; as primeiras threads levam o resto
+    vector<MatchResult> shares(threads);
+    vector<thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        uint64_t games = options.gamesPerMatch / threads + (uint64_t(t) < options.gamesPerMatch % threads ? 1 : 0);
+        uint64_t seed = mixSeed(matchSeed ^ (uint64_t(t) << 32));
+        MatchResult& share = shares[t];
+
+        workers.emplace_back([this, &config, games, seed, &share]() {
+            switch (options.boardOption) {
+                case 1: playShare<4, 4, 4>(config, options, games, seed, share); break;
+                case 2: playShare<5, 5, 4>(config, options, games, seed, share); break;
+                case 3: playShare<15, 15, 5>(config, options, games, seed, share); break;
+                default: playShare<3, 3, 3>(config, options, games, seed, share); break;
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+
+    MatchResult total;
+    total.config = config;
+    for (const MatchResult& share : shares) {
+        total.games += share.games;
+        total.xWins += share.xWins;
+        total.draws += share.draws;
+        total.oWins += share.oWins;
+        total.illegalMoves += share.illegalMoves;
+    }
+    total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+string SelfPlay::difficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return "FACIL";
+        case Difficulty::MEDIUM: return "MEDIO";
+        case Difficulty::HARD: return "DIFICIL";
+        case Difficulty::MCTS: return "MCTS";
+    }
+    return "?";
+}
+
+bool SelfPlay::parseDifficulty(const string& name, Difficulty& difficulty) {
+    string lower = name;
+    transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return char(tolower(c)); });
+    if (lower == "easy" || lower == "facil") difficulty = Difficulty::EASY;
+    else if (lower == "medium" || lower == "medio") difficulty = Difficulty::MEDIUM;
+    else if (lower == "hard" || lower == "dificil") difficulty = Difficulty::HARD;
+    else if (lower == "mcts") difficulty = Difficulty::MCTS;
+    else return false;
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "AIPlayer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * @struct MatchConfig
+ * @brief Um confronto da simulação: dificuldade de quem joga com X e com O
+ */
+struct MatchConfig {
+    Difficulty x;
+    Difficulty o;
+};
+
+/*
+ * @struct MatchResult
+ * @brief Placar agregado de um confronto
+ */
+struct MatchResult {
+    MatchConfig config;
+    uint64_t games = 0;
+    uint64_t xWins = 0;
+    uint64_t draws = 0;
+    uint64_t oWins = 0;
+    uint64_t illegalMoves = 0;  // Jogadas inválidas (contam como derrota de quem jogou)
+    double seconds = 0.0;       // Tempo de parede do confronto
+};
+
+/*
+ * @struct SelfPlayOptions
+ * @brief Parâmetros da simulação
+ */
+struct SelfPlayOptions {
+    int boardOption = 0;        // 0 = 3x3, 1 = 4x4 (K4), 2 = 5x5 (K4), 3 = 15x15 (K5)
+    uint64_t gamesPerMatch = 10000;
+    int threads = 0;            // 0 = um por núcleo
+    uint64_t seed = 1;          // Mesma semente e mesmo número de threads -> mesmos resultados
+    SearchLimits limits;        // Orçamento da IA Difícil fora do 3x3
+    MCTSLimits mctsLimits;      // Orçamento da IA Monte Carlo (uma thread por partida)
+    string endgameDirectory;    // Livro ou banco de finais da IA Difícil (vazio = nenhum)
+};
+
+/*
+ * @class SelfPlay
+ * @brief Simulador sem interface gráfica: IA contra IA em várias threads
+ *
+ * Cada thread tem seus próprios AIPlayer, cada um com gerador aleatório
+ * semeado a partir da semente da simulação, da thread e do confronto. A
+ * árvore do 3x3 é compartilhada e imutável, então nada é sincronizado
+ * durante as partidas; os placares de cada thread são somados no fim.
+ */
+class SelfPlay {
+public:
+    explicit SelfPlay(const SelfPlayOptions& options);
+
+    MatchResult play(const MatchConfig& config); // joga gamesPerMatch partidas do confronto
+    int getThreads() const { return threads; }
+
+    static string difficultyName(Difficulty difficulty);
+    static bool parseDifficulty(const string& name, Difficulty& difficulty);
+
+private:
+    SelfPlayOptions options;
+    int threads;
+    uint64_t matchCounter;      // Diferencia as sementes de confrontos sucessivos
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "SolvedTable.h"
+#include <array>
+using namespace std;
+
+namespace {
+
+using SolvedTable = array<SolvedEntry, Bitboard::NUM_RANKS>;
+
+/*
+ * @brief Resolve todas as 3^9 posições por análise retrógrada
+ *
+ * Jogar em uma casa só aumenta o índice ternário, então percorrer os índices
+ * do maior para o menor garante que todos os filhos já estejam resolvidos.
+ */
+constexpr SolvedTable buildSolvedTable() {
+    SolvedTable table{};
+    
+    for (int rank = Bitboard::NUM_RANKS - 1; rank >= 0; --rank) {
+        uint16_t x = 0, o = 0;
+        int countX = 0, countO = 0;
+        int rest = rank;
+        for (int i = 0; i < 9; ++i) {
+            int cell = rest % 3;
+            rest /= 3;
+            if (cell == 1) { x |= uint16_t(1u << i); ++countX; }
+            if (cell == 2) { o |= uint16_t(1u << i); ++countO; }
+        }
+        
+        SolvedEntry entry{0, 0, 0};
+        
+        // Posições impossíveis ficam zeradas
+        if (countX != countO && countX != countO + 1) {
+            table[rank] = entry;
+            continue;
+        }
+        
+        // Posição encerrada: quem acabou de jogar venceu, ou deu velha
+        if (Bitboard::hasLine(x) || Bitboard::hasLine(o)) {
+            entry.value = -1;
+            table[rank] = entry;
+            continue;
+        }
+        uint16_t occupied = x | o;
+        if (occupied == Bitboard::FULL) {
+            table[rank] = entry;
+            continue;
+        }
+        
+        int mark = (countX == countO) ? 1 : 2;
+        bool first = true;
+        for (int i = 0; i < 9; ++i) {
+            if (occupied & (1u << i)) continue;
+            
+            const SolvedEntry& child = table[rank + mark * Bitboard::POW3[i]];
+            int value = -child.value;
+            int distance = child.distance + 1;
+            
+            // Vitórias mais rápidas são melhores; derrotas e empates, mais demoradas
+            bool better = first || value > entry.value ||
+                (value == entry.value && (value > 0 ? distance < entry.distance : distance > entry.distance));
+            bool equal = !first && value == entry.value && distance == entry.distance;
+            
+            if (better) {
+                entry.value = int8_t(value);
+                entry.distance = uint8_t(distance);
+                entry.bestMoves = uint16_t(1u << i);
+                first = false;
+            } else if (equal) {
+                entry.bestMoves |= uint16_t(1u << i);
+            }
+        }
+        table[rank] = entry;
+    }
+    
+    return table;
+}
+
+constexpr SolvedTable SOLVED_TABLE = buildSolvedTable();
+
+// O tabuleiro vazio é empate e as 9 aberturas empatam com jogo perfeito
+static_assert(SOLVED_TABLE[0].value == 0 && SOLVED_TABLE[0].distance == 9 &&
+              SOLVED_TABLE[0].bestMoves == Bitboard::FULL, "tabela resolvida inconsistente");
+
+}
+
+const SolvedEntry& solvedEntry(int rank) {
+    return SOLVED_TABLE[rank];
+}
@@ -0,0 +1,25 @@
+#ifndef SOLVEDTABLE_H
+#define SOLVEDTABLE_H
+
+#include "Bitboard.h"
+
+/*
+ * @struct SolvedEntry
+ * @brief Resultado teórico de uma posição, sempre do ponto de vista de quem joga
+ */
+struct SolvedEntry {
+    int8_t value;        // +1 vitória, 0 empate, -1 derrota (com jogo perfeito)
+    uint8_t distance;    // Número de jogadas até o fim da partida
+    uint16_t bestMoves;  // Máscara das casas que mantêm o resultado ótimo
+};
+
+/*
+ * @brief Consulta a tabela do jogo resolvido, gerada em tempo de compilação
+ * @param rank índice ternário do tabuleiro (Bitboard::rank())
+ *
+ * Vitórias preferem o menor caminho e derrotas o maior. Posições impossíveis
+ * ou encerradas têm bestMoves == 0.
+ */
+const SolvedEntry& solvedEntry(int rank);
+
+#endif
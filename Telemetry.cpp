@@ -0,0 +1,113 @@
+#include "Telemetry.h"
+#include <iomanip>
+using namespace std;
+
+const char* movePathName(MovePath path) {
+    switch (path) {
+        case MovePath::RANDOM: return "random";
+        case MovePath::EASY: return "easy";
+        case MovePath::MEDIUM: return "medium";
+        case MovePath::BOOK: return "book";
+        case MovePath::ENDGAME: return "endgame";
+        case MovePath::SOLVED_TABLE: return "solved_table";
+        case MovePath::SEARCH: return "search";
+        case MovePath::MCTS: return "mcts";
+        case MovePath::PONDER: return "ponder";
+        default: return "?";
+    }
+}
+
+string difficultyName(int difficulty) {
+    static const char* NAMES[Telemetry::DIFFICULTIES] = {"easy", "medium", "hard", "mcts"};
+    return difficulty >= 0 && difficulty < Telemetry::DIFFICULTIES ? NAMES[difficulty] : "?";
+}
+
+void LatencyHistogram::add(int64_t micros) {
+    int bucket = micros > 1 ? 63 - __builtin_clzll(uint64_t(micros)) : 0;
+    if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+    ++counts[bucket];
+    ++total;
+    if (micros > maxMicros) maxMicros = micros;
+}
+
+int64_t LatencyHistogram::percentile(double fraction) const {
+    if (total == 0) return 0;
+    uint64_t target = uint64_t(fraction * double(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= target) {
+            int64_t upper = int64_t(1) << (bucket + 1);
+            return upper < maxMicros ? upper : maxMicros;
+        }
+    }
+    return maxMicros;
+}
+
+void Telemetry::record(MoveRecord move) {
+    move.sequence = ++count;
+    if (history.size() < HISTORY) history.push_back(move);
+    else history[(move.sequence - 1) % HISTORY] = move;
+
+    Summary& summary = summaries[move.difficulty < DIFFICULTIES ? move.difficulty : 0];
+    ++summary.decisions;
+    ++summary.paths[size_t(move.path)];
+    summary.latency.add(move.latencyMicros);
+    summary.nodesVisited += move.nodesVisited;
+    summary.ttProbes += move.ttProbes;
+    summary.ttHits += move.ttHits;
+    if (move.ponderHit) ++summary.ponderHits;
+}
+
+const MoveRecord& Telemetry::last() const {
+    return history[(count - 1) % HISTORY];
+}
+
+void Telemetry::writeJson(ostream& out, uint64_t after) const {
+    streamsize precision = out.precision(); // restaurada no fim: a saída é de quem chamou
+
+    // Decisões em ordem: o anel começa na mais antiga ainda guardada
+    size_t first = count > HISTORY ? size_t(count % HISTORY) : 0;
+    for (size_t i = 0; i < history.size(); ++i) {
+        const MoveRecord& move = history[(first + i) % history.size()];
+        if (move.sequence <= after) continue;
+        out << "{\"type\":\"move\",\"seq\":" << move.sequence
+            << ",\"difficulty\":\"" << difficultyName(move.difficulty) << "\""
+            << ",\"path\":\"" << movePathName(move.path) << "\""
+            << ",\"ply\":" << move.ply
+            << ",\"latency_us\":" << move.latencyMicros
+            << ",\"nodes_visited\":" << move.nodesVisited
+            << ",\"nodes_built\":" << move.nodesBuilt
+            << ",\"tree_nodes\":" << move.treeNodes
+            << ",\"bytes_held\":" << move.bytesHeld
+            << ",\"tt_probes\":" << move.ttProbes
+            << ",\"tt_hits\":" << move.ttHits
+            << ",\"ponder_hit\":" << (move.ponderHit ? "true" : "false") << "}\n";
+    }
+
+    for (int difficulty = 0; difficulty < DIFFICULTIES; ++difficulty) {
+        const Summary& summary = summaries[difficulty];
+        if (summary.decisions == 0) continue;
+
+        out << "{\"type\":\"summary\",\"difficulty\":\"" << difficultyName(difficulty) << "\""
+            << ",\"decisions\":" << summary.decisions << ",\"paths\":{";
+        bool firstPath = true;
+        for (size_t path = 0; path < size_t(MovePath::COUNT); ++path) {
+            if (summary.paths[path] == 0) continue;
+            out << (firstPath ? "" : ",") << "\"" << movePathName(MovePath(path)) << "\":" << summary.paths[path];
+            firstPath = false;
+        }
+        out << "},\"latency_us\":{\"p50\":" << summary.latency.percentile(0.5)
+            << ",\"p90\":" << summary.latency.percentile(0.9)
+            << ",\"p99\":" << summary.latency.percentile(0.99)
+            << ",\"max\":" << summary.latency.max() << ",\"buckets\":[";
+        for (int bucket = 0; bucket < LatencyHistogram::BUCKETS; ++bucket) {
+            out << (bucket ? "," : "") << summary.latency.buckets()[bucket];
+        }
+        out << "]},\"nodes_visited\":" << summary.nodesVisited
+            << setprecision(4)
+            << ",\"tt_hit_rate\":" << (summary.ttProbes ? double(summary.ttHits) / summary.ttProbes : 0.0)
+            << ",\"ponder_hit_rate\":" << double(summary.ponderHits) / summary.decisions << "}\n";
+        out.precision(precision);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * @brief Caminho que produziu a jogada da IA
+ */
+enum class MovePath : uint8_t {
+    RANDOM,         // Não era a vez da IA ou não havia estratégia
+    EASY,
+    MEDIUM,
+    BOOK,           // Livro de posições mapeado
+    ENDGAME,        // Banco de finais em disco
+    SOLVED_TABLE,   // Tabela resolvida do 3x3
+    SEARCH,         // Motor alfa-beta
+    MCTS,           // Busca Monte Carlo
+    PONDER,         // Resposta já calculada durante a vez do adversário
+    COUNT
+};
+
+const char* movePathName(MovePath path);
+
+/*
+ * @struct MoveRecord
+ * @brief Custo de uma decisão da IA
+ */
+struct MoveRecord {
+    uint64_t sequence = 0;      // Decisão n desta IA
+    uint8_t difficulty = 0;     // Difficulty como índice (EASY = 0 ... MCTS = 3)
+    MovePath path = MovePath::RANDOM;
+    int ply = 0;                // Peças no tabuleiro quando a IA decidiu
+    int64_t latencyMicros = 0;  // Duração de getBestMove
+    uint64_t nodesVisited = 0;  // Nós do alfa-beta ou simulações da Monte Carlo
+    uint64_t nodesBuilt = 0;    // Nós novos na árvore Monte Carlo
+    uint64_t treeNodes = 0;     // Nós mantidos (árvore do 3x3 e árvores Monte Carlo)
+    uint64_t bytesHeld = 0;     // Memória da IA: árvores, tabela de transposição, ponder
+    uint64_t ttProbes = 0;      // Consultas à tabela de transposição nesta busca
+    uint64_t ttHits = 0;
+    bool ponderHit = false;     // Resposta veio do ponder
+};
+
+/*
+ * @class LatencyHistogram
+ * @brief Histograma de latência em faixas de potência de 2 microssegundos
+ *
+ * A faixa i conta latências em [2^i, 2^(i+1)) us (a faixa 0 inclui o zero);
+ * percentis saem com a precisão da faixa, o que basta para ver a cauda.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 32;
+
+    void add(int64_t micros);
+    uint64_t count() const { return total; }
+    int64_t max() const { return maxMicros; }
+    int64_t percentile(double fraction) const; // limite superior da faixa
+    const uint64_t* buckets() const { return counts; }
+
+private:
+    uint64_t counts[BUCKETS] = {};
+    uint64_t total = 0;
+    int64_t maxMicros = 0;
+};
+
+/*
+ * @class Telemetry
+ * @brief Contadores das decisões de uma IA, por dificuldade
+ *
+ * record() é chamado a cada getBestMove e custa um punhado de somas: as
+ * últimas HISTORY decisões ficam em um anel de tamanho fixo (memória
+ * constante mesmo em autojogo) e o resto vira resumo por dificuldade.
+ * writeJson() exporta tudo em linhas JSON.
+ */
+class Telemetry {
+public:
+    static constexpr int DIFFICULTIES = 4;
+    static constexpr size_t HISTORY = 1024;
+
+    struct Summary {
+        uint64_t decisions = 0;
+        uint64_t paths[size_t(MovePath::COUNT)] = {};
+        LatencyHistogram latency;
+        uint64_t nodesVisited = 0;
+        uint64_t ttProbes = 0;
+        uint64_t ttHits = 0;
+        uint64_t ponderHits = 0;
+    };
+
+    void record(MoveRecord move); // numera a decisão e atualiza o resumo
+    uint64_t decisions() const { return count; }
+    const MoveRecord& last() const; // só com decisions() > 0
+    const Summary& summary(int difficulty) const { return summaries[difficulty]; }
+
+    // decisões guardadas com número maior que after, depois um resumo por dificuldade
+    void writeJson(ostream& out, uint64_t after = 0) const;
+
+private:
+    Summary summaries[DIFFICULTIES];
+    vector<MoveRecord> history; // Anel: a decisão n fica em history[n % HISTORY]
+    uint64_t count = 0;
+};
+
+string difficultyName(int difficulty); // "easy", "medium", "hard", "mcts"
+
+#endif
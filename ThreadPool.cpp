@@ -0,0 +1,95 @@
+#include "ThreadPool.h"
+using namespace std;
+
+namespace {
+// Índice da thread do pool que está executando (-1 fora do pool)
+thread_local int currentWorker = -1;
+thread_local const ThreadPool* currentPool = nullptr;
+}
+
+ThreadPool::ThreadPool(int threads) : queued(0), pending(0), nextQueue(0), stopping(false) {
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; ++i) {
+        queues.push_back(make_unique<Queue>());
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(Task task) {
+    int index = (currentPool == this) ? currentWorker : int(nextQueue++ % queues.size());
+    {
+        lock_guard<mutex> guard(queues[index]->lock);
+        queues[index]->tasks.push_back(move(task));
+    }
+    ++pending;
+    ++queued;
+
+    // Passa pelo mutex antes de avisar para nenhuma thread perder o sinal
+    { lock_guard<mutex> guard(sleepLock); }
+    wakeUp.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(sleepLock);
+    idle.wait(guard, [this]() { return pending.load() == 0; });
+}
+
+/*
+ * @brief Fim da própria fila primeiro; se vazia, início das filas das outras
+ */
+bool ThreadPool::takeTask(int index, Task& task) {
+    {
+        Queue& own = *queues[index];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued;
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(index + offset) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentWorker = index;
+    currentPool = this;
+
+    Task task;
+    while (true) {
+        if (takeTask(index, task)) {
+            task(index);
+            task = nullptr;
+            if (--pending == 0) {
+                lock_guard<mutex> guard(sleepLock);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> guard(sleepLock);
+        wakeUp.wait(guard, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/*
+ * @class ThreadPool
+ * @brief Conjunto fixo de threads com roubo de tarefas (work stealing)
+ *
+ * Cada thread tem sua própria fila: tira tarefas do fim da sua fila e,
+ * quando ela esvazia, rouba do início da fila de outra thread. Tarefas
+ * enviadas de dentro de uma tarefa vão para a fila da própria thread.
+ * A tarefa recebe o índice da thread que a executa, para usar estado
+ * próprio da thread sem sincronização.
+ */
+class ThreadPool {
+public:
+    using Task = function<void(int)>;
+
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    void submit(Task task);
+    void wait(); // bloqueia até todas as tarefas enviadas terminarem
+    int size() const { return int(workers.size()); }
+
+private:
+    struct Queue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    mutex sleepLock;
+    condition_variable wakeUp;      // Há tarefa nova ou o pool está encerrando
+    condition_variable idle;        // Todas as tarefas terminaram
+    atomic<int> queued;             // Tarefas nas filas
+    atomic<int> pending;            // Tarefas ainda não concluídas
+    atomic<unsigned> nextQueue;     // Distribuição das tarefas enviadas de fora
+    bool stopping;
+
+    void workerLoop(int index);
+    bool takeTask(int index, Task& task);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "TranspositionTable.h"
+using namespace std;
+
+TranspositionTable::TranspositionTable(size_t entries) {
+    size_t size = 1;
+    while (size < entries) size <<= 1;
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].check.store(0, memory_order_relaxed);
+        slots[i].data.store(0, memory_order_relaxed);
+    }
+}
+
+/*
+ * @brief Layout: pontuação nos 32 bits baixos, depois profundidade (8 bits),
+ * limite (8 bits) e jogada + 1 (16 bits, zero = sem jogada)
+ */
+uint64_t TranspositionTable::pack(int score, int depth, Bound bound, int move) {
+    return uint64_t(uint32_t(score)) |
+           (uint64_t(uint8_t(depth)) << 32) |
+           (uint64_t(uint8_t(bound)) << 40) |
+           (uint64_t(uint16_t(move + 1)) << 48);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(memory_order_relaxed);
+    uint64_t check = slot.check.load(memory_order_relaxed);
+    if ((check ^ data) != key || data == 0) return false;
+
+    entry.score = int32_t(uint32_t(data));
+    entry.depth = int(uint8_t(data >> 32));
+    entry.bound = Bound(uint8_t(data >> 40));
+    entry.move = int(uint16_t(data >> 48)) - 1;
+    return true;
+}
+
+/*
+ * @brief Grava a posição; outra posição no mesmo slot é sempre substituída,
+ * a mesma posição só se a nova busca for ao menos tão profunda
+ */
+void TranspositionTable::store(uint64_t key, int score, int depth, Bound bound, int move) {
+    Slot& slot = slots[key & mask];
+    uint64_t oldData = slot.data.load(memory_order_relaxed);
+    uint64_t oldCheck = slot.check.load(memory_order_relaxed);
+    if ((oldCheck ^ oldData) == key && int(uint8_t(oldData >> 32)) > depth) return;
+
+    uint64_t data = pack(score, depth, bound, move);
+    slot.data.store(data, memory_order_relaxed);
+    slot.check.store(key ^ data, memory_order_relaxed);
+}
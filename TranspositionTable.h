@@ -0,0 +1,59 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+using namespace std;
+
+enum class Bound : uint8_t {
+    NONE,
+    EXACT,  // Valor exato
+    LOWER,  // Corte beta: o valor é pelo menos score
+    UPPER   // Nenhuma jogada superou alfa: o valor é no máximo score
+};
+
+/*
+ * @struct TTEntry
+ * @brief Entrada decodificada da tabela de transposição
+ */
+struct TTEntry {
+    int score = 0;
+    int depth = 0;
+    Bound bound = Bound::NONE;
+    int move = -1;              // Melhor casa encontrada (-1 se nenhuma)
+};
+
+/*
+ * @class TranspositionTable
+ * @brief Tabela de transposição sem travas, compartilhada pelas threads da busca
+ *
+ * Cada posição ocupa dois inteiros atômicos de 64 bits: os dados compactados
+ * e a chave Zobrist XOR os dados. Se duas threads gravarem ao mesmo tempo e
+ * a leitura pegar metade de cada gravação, o XOR não bate com a chave e a
+ * entrada é simplesmente ignorada; não há mutex nem espera.
+ */
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t entries); // arredondado para potência de 2
+
+    bool probe(uint64_t key, TTEntry& entry) const;
+    void store(uint64_t key, int score, int depth, Bound bound, int move);
+    void clear();
+    size_t size() const { return mask + 1; }
+    size_t memoryBytes() const { return size() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        atomic<uint64_t> check;  // chave ^ dados
+        atomic<uint64_t> data;   // pontuação, profundidade, limite e jogada
+    };
+
+    unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    static uint64_t pack(int score, int depth, Bound bound, int move);
+};
+
+#endif
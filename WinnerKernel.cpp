@@ -0,0 +1,127 @@
+#include "WinnerKernel.h"
+using namespace std;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WINNER_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/*
+ * Cada tabuleiro ocupa 32 bits na memória: X nos 16 bits baixos e O nos altos.
+ * O teste de linha é o mesmo para as duas metades, então os registradores são
+ * usados como estão, e o movemask devolve 4 bits por tabuleiro: bits 0-1 da
+ * metade X e bits 2-3 da metade O.
+ */
+static_assert(sizeof(Bitboard) == 4, "o kernel supõe tabuleiros de 32 bits (X, O)");
+
+// Vencedor a partir dos 4 bits do movemask; X tem prioridade, como em winner()
+const Player WINNER_FROM_BITS[16] = {
+    Player::NONE, Player::X, Player::X, Player::X,
+    Player::O,    Player::X, Player::X, Player::X,
+    Player::O,    Player::X, Player::X, Player::X,
+    Player::O,    Player::X, Player::X, Player::X,
+};
+
+void evaluateScalar(const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal) {
+    for (size_t i = 0; i < count; ++i) {
+        winners[i] = boards[i].winner();
+        terminal[i] = (winners[i] != Player::NONE || boards[i].isFull()) ? 1 : 0;
+    }
+}
+
+// Converte os movemasks de um bloco de tabuleiros nas saídas
+inline void storeBlock(uint32_t lineBits, uint32_t fullBits, int boardsInBlock,
+                       Player* winners, uint8_t* terminal) {
+    for (int j = 0; j < boardsInBlock; ++j) {
+        Player winner = WINNER_FROM_BITS[(lineBits >> (4 * j)) & 0xF];
+        winners[j] = winner;
+        terminal[j] = uint8_t((winner != Player::NONE) | ((fullBits >> (4 * j)) & 1));
+    }
+}
+
+#ifdef WINNER_KERNEL_X86
+
+__attribute__((target("sse2")))
+void evaluateSSE2(const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal) {
+    const __m128i full = _mm_set1_epi16(short(Bitboard::FULL));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(boards + i));
+
+        __m128i lines = _mm_setzero_si128();
+        for (uint16_t win : Bitboard::WIN_MASKS) {
+            __m128i m = _mm_set1_epi16(short(win));
+            lines = _mm_or_si128(lines, _mm_cmpeq_epi16(_mm_and_si128(v, m), m));
+        }
+        // Metade baixa de cada tabuleiro passa a ter X | O
+        __m128i occupied = _mm_or_si128(v, _mm_srli_epi32(v, 16));
+        __m128i isFull = _mm_cmpeq_epi16(occupied, full);
+
+        storeBlock(uint32_t(_mm_movemask_epi8(lines)), uint32_t(_mm_movemask_epi8(isFull)), 4,
+                   winners + i, terminal + i);
+    }
+    evaluateScalar(boards + i, count - i, winners + i, terminal + i);
+}
+
+__attribute__((target("avx2")))
+void evaluateAVX2(const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal) {
+    const __m256i full = _mm256_set1_epi16(short(Bitboard::FULL));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards + i));
+
+        __m256i lines = _mm256_setzero_si256();
+        for (uint16_t win : Bitboard::WIN_MASKS) {
+            __m256i m = _mm256_set1_epi16(short(win));
+            lines = _mm256_or_si256(lines, _mm256_cmpeq_epi16(_mm256_and_si256(v, m), m));
+        }
+        __m256i occupied = _mm256_or_si256(v, _mm256_srli_epi32(v, 16));
+        __m256i isFull = _mm256_cmpeq_epi16(occupied, full);
+
+        storeBlock(uint32_t(_mm256_movemask_epi8(lines)), uint32_t(_mm256_movemask_epi8(isFull)), 8,
+                   winners + i, terminal + i);
+    }
+    evaluateSSE2(boards + i, count - i, winners + i, terminal + i);
+}
+
+#endif
+
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef WINNER_KERNEL_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 :
+                                   __builtin_cpu_supports("sse2") ? SimdLevel::SSE2 : SimdLevel::SCALAR;
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR: return "escalar";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+    }
+    return "?";
+}
+
+void evaluateBatch(SimdLevel level, const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal) {
+    // Níveis acima do suportado pela CPU caem para o melhor disponível
+    if (level > detectSimdLevel()) level = detectSimdLevel();
+
+    switch (level) {
+#ifdef WINNER_KERNEL_X86
+        case SimdLevel::AVX2: evaluateAVX2(boards, count, winners, terminal); return;
+        case SimdLevel::SSE2: evaluateSSE2(boards, count, winners, terminal); return;
+#endif
+        default: evaluateScalar(boards, count, winners, terminal); return;
+    }
+}
+
+void evaluateBatch(const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal) {
+    evaluateBatch(detectSimdLevel(), boards, count, winners, terminal);
+}
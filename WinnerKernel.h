@@ -0,0 +1,32 @@
+#ifndef WINNERKERNEL_H
+#define WINNERKERNEL_H
+
+#include "Bitboard.h"
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+enum class SimdLevel {
+    SCALAR, // Uma máscara por vez (qualquer CPU)
+    SSE2,   // 4 tabuleiros por instrução (registradores de 128 bits)
+    AVX2    // 8 tabuleiros por instrução (registradores de 256 bits)
+};
+
+/*
+ * @brief Vencedor e fim de jogo de muitos tabuleiros 3x3 de uma vez
+ *
+ * Para cada boards[i] grava winners[i] (igual a boards[i].winner()) e
+ * terminal[i] (1 se alguém venceu ou o tabuleiro está cheio, igual a
+ * boards[i].isGameOver()). Os tabuleiros são lidos como estão na memória
+ * (pares de 16 bits X, O), sem reorganizar, e cada linha vencedora é testada
+ * em todos eles com um AND e uma comparação vetorial.
+ *
+ * A versão sem nível escolhe a melhor disponível na CPU (detectada uma vez).
+ */
+void evaluateBatch(const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal);
+void evaluateBatch(SimdLevel level, const Bitboard* boards, size_t count, Player* winners, uint8_t* terminal);
+
+SimdLevel detectSimdLevel(); // melhor nível suportado pela CPU atual
+const char* simdLevelName(SimdLevel level);
+
+#endif
@@ -1,7 +1,33 @@
 #include "Game.h"
+#include "EngineProtocol.h"
+#include "Logger.h"
+#include <iostream>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool protocolMode = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--protocol") {
+            protocolMode = true;
+        } else if (arg == "--log" && i + 1 < argc) {
+            // --log trace|debug|info|warn|error|off: nível das mensagens no console
+            LogLevel level;
+            if (!Logger::parseLevel(argv[++i], level)) {
+                std::cerr << "Nível de log desconhecido: " << argv[i] << std::endl;
+                return 1;
+            }
+            Logger::setLevel(level);
+        }
+    }
+    
+    // --protocol: motor em modo texto pela entrada/saída padrão, sem abrir janela
+    if (protocolMode) {
+        EngineProtocol protocol(std::cin, std::cout);
+        return protocol.run();
+    }
+    
     Game game;
     game.run();
     return 0;
-}
\ No newline at end of file
+}
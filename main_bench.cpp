@@ -0,0 +1,386 @@
+#include "AIPlayer.h"
+#include "GameTree.h"
+#include "SearchEngine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+using namespace std;
+
+// Benchmarks dos caminhos críticos da IA, sem SFML.
+// Uso: bench [--filter TEXTO] [--min-time MS] [--json ARQUIVO]
+//            [--baseline ARQUIVO] [--tolerance FRAÇÃO]
+// --json grava um resultado por linha (JSON); --baseline compara com um
+// arquivo gravado antes e termina com código 1 se algum caso regrediu.
+
+// Contador global de alocações: toda chamada de new passa por aqui
+static atomic<uint64_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size ? size : 1)) return memory;
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+/*
+ * @struct BenchResult
+ * @brief Medição de um caso: tempo e alocações por operação, mais uma
+ * métrica própria opcional (nós/s, KB de pico...)
+ */
+struct BenchResult {
+    string name;
+    uint64_t operations = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    string metric;              // Nome da métrica extra (vazio se não houver)
+    double metricValue = 0.0;
+};
+
+struct BenchOptions {
+    string filter;
+    chrono::milliseconds minTime{200};
+    string jsonPath;
+    string baselinePath;
+    double tolerance = 0.15;    // Regressão: mais de 15% mais lento que a base
+};
+
+size_t peakResidentKB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return size_t(usage.ru_maxrss) / 1024;
+#else
+    return size_t(usage.ru_maxrss);
+#endif
+#endif
+}
+
+/*
+ * @brief Repete body em lotes crescentes até somar minTime; body recebe o
+ * tamanho do lote e devolve quantas operações fez
+ */
+BenchResult measure(const string& name, const BenchOptions& options, const function<uint64_t(uint64_t)>& body) {
+    BenchResult result;
+    result.name = name;
+    body(1); // aquecimento: caches, tabelas e árvores construídas no primeiro uso
+
+    uint64_t batch = 1;
+    double seconds = 0.0;
+    uint64_t allocations = 0;
+    while (true) {
+        uint64_t allocationsBefore = allocationCount.load(memory_order_relaxed);
+        auto start = chrono::steady_clock::now();
+        uint64_t done = body(batch);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        allocations += allocationCount.load(memory_order_relaxed) - allocationsBefore;
+        result.operations += done;
+        seconds += elapsed;
+        if (seconds * 1000.0 >= double(options.minTime.count())) break;
+        if (elapsed * 1000.0 < double(options.minTime.count()) / 4) batch *= 2;
+    }
+    result.nsPerOp = seconds * 1e9 / double(result.operations);
+    result.allocsPerOp = double(allocations) / double(result.operations);
+    return result;
+}
+
+// Leva a IA até a posição: volta à raiz e reproduz as jogadas pela árvore
+template <int Rows, int Cols, int K>
+void replay(AIPlayer<Rows, Cols, K>& player, const vector<pair<int, int>>& moves) {
+    player.resetTree();
+    for (const auto& move : moves) player.updateTree(move);
+}
+
+struct BenchPosition {
+    const char* phase;
+    vector<pair<int, int>> moves;   // Jogadas a partir do tabuleiro vazio (X começa)
+};
+
+// Abertura, meio-jogo e final do 3x3 (sem vencedor, cada um com a vez de um lado)
+const vector<BenchPosition> POSITIONS_3X3 = {
+    { "abertura", {} },
+    { "meio", { {1, 1}, {0, 0}, {0, 2} } },
+    { "final", { {1, 1}, {0, 0}, {0, 2}, {2, 0}, {1, 0}, {1, 2} } },
+};
+
+const char* difficultyKey(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return "easy";
+        case Difficulty::MEDIUM: return "medium";
+        case Difficulty::HARD: return "hard";
+        case Difficulty::MCTS: return "mcts";
+    }
+    return "?";
+}
+
+void runAll(const BenchOptions& options, vector<BenchResult>& results) {
+    auto wanted = [&](const string& name) {
+        return options.filter.empty() || name.find(options.filter) != string::npos;
+    };
+
+    // Construção da árvore completa do 3x3 (o que resetTree fazia antes de ser só um cursor)
+    if (wanted("gametree/build")) {
+        BenchResult result = measure("gametree/build", options, [](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                GameTree tree;
+                if (tree.size() == 0) abort();
+            }
+            return n;
+        });
+        result.metric = "peak_rss_kb";
+        result.metricValue = double(peakResidentKB());
+        results.push_back(result);
+    }
+
+    if (wanted("ai/resetTree")) {
+        AIPlayer<3, 3, 3> player(Player::O, Difficulty::HARD, 1);
+        player.setVerbose(false);
+        results.push_back(measure("ai/resetTree", options, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) player.resetTree();
+            return n;
+        }));
+    }
+
+    // Uma partida inteira navegada pela árvore: custo por updateTree
+    if (wanted("ai/updateTree")) {
+        AIPlayer<3, 3, 3> player(Player::O, Difficulty::HARD, 1);
+        player.setVerbose(false);
+        const vector<pair<int, int>> game = { {1, 1}, {0, 0}, {0, 2}, {2, 0}, {1, 0}, {1, 2}, {0, 1}, {2, 1}, {2, 2} };
+        results.push_back(measure("ai/updateTree", options, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) replay(player, game);
+            return n * game.size();
+        }));
+    }
+
+    // getBestMove por dificuldade e fase; a semente fixa torna as escolhas repetíveis
+    const Difficulty difficulties[] = { Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD, Difficulty::MCTS };
+    for (Difficulty difficulty : difficulties) {
+        for (const BenchPosition& position : POSITIONS_3X3) {
+            string name = string("ai/getBestMove/") + difficultyKey(difficulty) + "/" + position.phase;
+            if (!wanted(name)) continue;
+
+            Player toMove = position.moves.size() % 2 == 0 ? Player::X : Player::O;
+            AIPlayer<3, 3, 3> player(toMove, difficulty, 1);
+            player.setVerbose(false);
+            MCTSLimits mctsLimits;
+            mctsLimits.playouts = 2000;
+            mctsLimits.threads = 1;
+            player.setMCTSLimits(mctsLimits);
+            replay(player, position.moves);
+
+            results.push_back(measure(name, options, [&](uint64_t n) {
+                for (uint64_t i = 0; i < n; ++i) {
+                    // A árvore Monte Carlo cresce a cada busca: recomeça para medir sempre o mesmo trabalho
+                    if (difficulty == Difficulty::MCTS) replay(player, position.moves);
+                    if (player.getBestMove().first < 0) abort();
+                }
+                return n;
+            }));
+        }
+    }
+
+    // Vazão do alfa-beta (sucessor do minimax): motor novo a cada busca, sem tabela aproveitada
+    auto searchBench = [&](auto engineTag, const string& name, uint64_t maxNodes) {
+        using Engine = decltype(engineTag);
+        if (!wanted(name)) return;
+        SearchLimits limits;
+        limits.maxNodes = maxNodes;
+        limits.threads = 1;
+        uint64_t nodes = 0;
+        BenchResult result = measure(name, options, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                Engine engine;
+                engine.search(typename Engine::Board(), limits);
+                nodes += engine.getStats().nodes;
+            }
+            return n;
+        });
+        result.metric = "nodes_per_s";
+        double nodesPerSearch = double(nodes) / double(result.operations + 1); // inclui o aquecimento
+        result.metricValue = nodesPerSearch / (result.nsPerOp * 1e-9);
+        results.push_back(result);
+    };
+    searchBench(SearchEngine<3, 3, 3>(), "search/3x3/solve", 0);
+    searchBench(SearchEngine<4, 4, 4>(), "search/4x4/200k", 200000);
+
+    // Board::checkWinner e isBoardFull repassam para a Position: mede as mesmas chamadas
+    if (wanted("board/checkWinner") || wanted("board/isBoardFull")) {
+        mt19937 rng(7);
+        vector<Position<3, 3, 3>> positions(1024);
+        for (auto& position : positions) {
+            int moves = int(rng() % 10);
+            for (int m = 0; m < moves && !position.isGameOver(); ++m) {
+                uint16_t empty = position.getBoard().emptyCells();
+                int skip = int(rng() % __builtin_popcount(empty));
+                while (skip-- > 0) empty &= empty - 1;
+                position.makeMove(__builtin_ctz(empty), position.sideToMove());
+            }
+        }
+        volatile int sink = 0;
+        if (wanted("board/checkWinner")) {
+            results.push_back(measure("board/checkWinner", options, [&](uint64_t n) {
+                int count = 0;
+                for (uint64_t i = 0; i < n; ++i) {
+                    for (const auto& position : positions) count += position.getWinner() != Player::NONE;
+                }
+                sink = sink + count;
+                return n * positions.size();
+            }));
+        }
+        if (wanted("board/isBoardFull")) {
+            results.push_back(measure("board/isBoardFull", options, [&](uint64_t n) {
+                int count = 0;
+                for (uint64_t i = 0; i < n; ++i) {
+                    for (const auto& position : positions) count += position.getBoard().isFull();
+                }
+                sink = sink + count;
+                return n * positions.size();
+            }));
+        }
+    }
+}
+
+string toJson(const BenchResult& result) {
+    ostringstream out;
+    out << setprecision(6) << "{\"name\":\"" << result.name << "\",\"ops\":" << result.operations
+        << ",\"ns_per_op\":" << result.nsPerOp << ",\"allocs_per_op\":" << result.allocsPerOp;
+    if (!result.metric.empty()) out << ",\"" << result.metric << "\":" << result.metricValue;
+    out << "}";
+    return out.str();
+}
+
+// Leitura mínima do formato gravado por toJson (um objeto por linha)
+bool fromJson(const string& line, BenchResult& result) {
+    auto field = [&](const string& key) -> string {
+        size_t at = line.find("\"" + key + "\":");
+        if (at == string::npos) return "";
+        at += key.size() + 3;
+        if (line[at] == '"') return line.substr(at + 1, line.find('"', at + 1) - at - 1);
+        return line.substr(at, line.find_first_of(",}", at) - at);
+    };
+    result.name = field("name");
+    string ns = field("ns_per_op"), allocs = field("allocs_per_op");
+    if (result.name.empty() || ns.empty()) return false;
+    result.nsPerOp = atof(ns.c_str());
+    result.allocsPerOp = atof(allocs.c_str());
+    return true;
+}
+
+/*
+ * @brief Compara com a base: tempo acima da tolerância ou mais alocações por
+ * operação contam como regressão
+ */
+int compareWithBaseline(const vector<BenchResult>& results, const BenchOptions& options) {
+    ifstream in(options.baselinePath);
+    if (!in) {
+        cout << "Base não encontrada: " << options.baselinePath << endl;
+        return 1;
+    }
+    vector<BenchResult> baseline;
+    string line;
+    while (getline(in, line)) {
+        BenchResult entry;
+        if (fromJson(line, entry)) baseline.push_back(entry);
+    }
+
+    int regressions = 0;
+    cout << endl << "Comparação com " << options.baselinePath << " (tolerância "
+         << fixed << setprecision(0) << options.tolerance * 100 << "%)" << endl;
+    for (const BenchResult& result : results) {
+        for (const BenchResult& base : baseline) {
+            if (base.name != result.name) continue;
+            double change = base.nsPerOp > 0 ? result.nsPerOp / base.nsPerOp - 1.0 : 0.0;
+            bool slower = change > options.tolerance;
+            bool moreAllocations = result.allocsPerOp > base.allocsPerOp + 0.01;
+            if (slower || moreAllocations) ++regressions;
+            cout << left << setw(36) << result.name << right << showpos << setprecision(1) << setw(8)
+                 << change * 100 << "%" << noshowpos
+                 << (slower ? "  REGRESSÃO (tempo)" : "") << (moreAllocations ? "  REGRESSÃO (alocações)" : "") << endl;
+        }
+    }
+    cout << (regressions ? to_string(regressions) + " regressão(ões)" : string("Sem regressões")) << endl;
+    return regressions ? 1 : 0;
+}
+
+void printUsage() {
+    cout << "Uso: bench [--filter TEXTO] [--min-time MS] [--json ARQUIVO]" << endl;
+    cout << "           [--baseline ARQUIVO] [--tolerance FRAÇÃO]" << endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            options.minTime = chrono::milliseconds(atoi(argv[++i]));
+        } else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            options.tolerance = atof(argv[++i]);
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    vector<BenchResult> results;
+    runAll(options, results);
+
+    cout << left << setw(36) << "Caso" << right << setw(14) << "ns/op" << setw(12) << "alocs/op"
+         << "  Métrica" << endl;
+    for (const BenchResult& result : results) {
+        cout << left << setw(36) << result.name << right << fixed << setprecision(1)
+             << setw(14) << result.nsPerOp << setprecision(2) << setw(12) << result.allocsPerOp;
+        if (!result.metric.empty()) cout << "  " << result.metric << " = " << setprecision(0) << result.metricValue;
+        cout << endl;
+    }
+
+    if (!options.jsonPath.empty()) {
+        ofstream out(options.jsonPath);
+        for (const BenchResult& result : results) out << toJson(result) << "\n";
+        if (!out) {
+            cout << "Erro ao gravar " << options.jsonPath << endl;
+            return 1;
+        }
+    }
+    return options.baselinePath.empty() ? 0 : compareWithBaseline(results, options);
+}
@@ -0,0 +1,91 @@
+#include "WinnerKernel.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+// Microbenchmark do kernel de vencedor em lote.
+// Uso: bench_winner [tabuleiros] [repetições]
+// Confere primeiro que todos os níveis dão o mesmo resultado que winner()
+// nas 3^9 posições (válidas ou não) e depois mede tabuleiros por segundo.
+
+namespace {
+
+Bitboard boardFromRank(int rank) {
+    Bitboard board;
+    for (int cell = 0; cell < Bitboard::CELLS; ++cell, rank /= 3) {
+        if (rank % 3 == 1) board.x |= Bitboard::Mask(1u << cell);
+        else if (rank % 3 == 2) board.o |= Bitboard::Mask(1u << cell);
+    }
+    return board;
+}
+
+bool verify(SimdLevel level, const vector<Bitboard>& boards) {
+    vector<Player> winners(boards.size());
+    vector<uint8_t> terminal(boards.size());
+    evaluateBatch(level, boards.data(), boards.size(), winners.data(), terminal.data());
+    for (size_t i = 0; i < boards.size(); ++i) {
+        if (winners[i] != boards[i].winner() || terminal[i] != (boards[i].isGameOver() ? 1 : 0)) {
+            cout << "ERRO (" << simdLevelName(level) << "): tabuleiro " << i << " difere de winner()" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : (size_t(1) << 20);
+    int repeats = argc > 2 ? atoi(argv[2]) : 50;
+
+    vector<Bitboard> all(Bitboard::NUM_RANKS);
+    for (uint32_t rank = 0; rank < Bitboard::NUM_RANKS; ++rank) all[rank] = boardFromRank(int(rank));
+
+    const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2 };
+    SimdLevel best = detectSimdLevel();
+    for (SimdLevel level : levels) {
+        if (level <= best && !verify(level, all)) return 1;
+    }
+    cout << "Verificação: " << Bitboard::NUM_RANKS << " posições idênticas a winner()/isGameOver()" << endl;
+
+    mt19937 rng(12345);
+    uniform_int_distribution<uint32_t> pick(0, Bitboard::NUM_RANKS - 1);
+    vector<Bitboard> boards(count);
+    for (Bitboard& board : boards) board = all[pick(rng)];
+    vector<Player> winners(count);
+    vector<uint8_t> terminal(count);
+
+    cout << "Tabuleiros: " << count << " x " << repeats << " repetições | CPU: " << simdLevelName(best) << endl;
+    cout << fixed << setprecision(1);
+
+    // Referência: um tabuleiro por vez, como Board::checkWinner
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            winners[i] = boards[i].winner();
+            terminal[i] = boards[i].isGameOver() ? 1 : 0;
+        }
+    }
+    double reference = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double referenceRate = double(count) * repeats / reference / 1e6;
+    cout << left << setw(22) << "checkWinner (1 a 1)" << right << setw(10) << referenceRate << " M/s" << endl;
+
+    uint64_t checksum = 0;
+    for (SimdLevel level : levels) {
+        if (level > best) continue;
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            evaluateBatch(level, boards.data(), count, winners.data(), terminal.data());
+            checksum += uint8_t(winners[r % count]) + terminal[r % count];
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double rate = double(count) * repeats / seconds / 1e6;
+        cout << left << setw(22) << (string("lote ") + simdLevelName(level)) << right << setw(10) << rate
+             << " M/s  (" << setprecision(2) << rate / referenceRate << "x)" << setprecision(1) << endl;
+    }
+    return checksum == 0xFFFFFFFFFFFFFFFFull; // impede que o laço seja eliminado
+}
@@ -0,0 +1,16 @@
+#include "EngineProtocol.h"
+#include <iostream>
+using namespace std;
+
+// Motor em modo texto (estilo UCI), sem SFML: um comando por linha.
+// Exemplo:
+//   setoption name difficulty value hard
+//   position startpos moves b2 a1
+//   go nodes 20000
+// Veja EngineProtocol.h para a lista de comandos.
+
+int main() {
+    ios::sync_with_stdio(false);
+    EngineProtocol protocol(cin, cout);
+    return protocol.run();
+}
@@ -0,0 +1,304 @@
+#include "Bitboard.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+// Gerador de carga para o servidor (Linux): muitas conexões jogando partidas
+// com jogadas aleatórias contra a IA, medindo o tempo de cada resposta dela.
+// Uso: loadgen (--unix CAMINHO | --tcp PORTA) [--sessions N] [--seconds S]
+//              [--think MS] [--seed S]
+// Exemplo: server --unix /tmp/velha.sock & loadgen --unix /tmp/velha.sock --sessions 5000 --think 100
+//
+// --think é a pausa de cada sessão antes da próxima jogada (0 = sem pausa, o
+// servidor fica saturado). Sessões por núcleo = sessões / núcleos que o
+// servidor usou, pela CPU que ele informa em "stats".
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+struct Target {
+    string unixPath;
+    int tcpPort = 0;
+};
+
+/*
+ * @struct Client
+ * @brief Uma sessão do gerador: o tabuleiro dela e o comando em espera
+ */
+struct Client {
+    int fd = -1;
+    Bitboard board;
+    Player side = Player::X;
+    string input;
+    Clock::time_point sentAt;
+    bool timing = false;    // Esperando jogada da IA: a resposta entra na latência
+    uint64_t games = 0;
+};
+
+void printUsage() {
+    cout << "Uso: loadgen (--unix CAMINHO | --tcp PORTA) [--sessions N] [--seconds S]" << endl;
+    cout << "             [--think MS] [--seed S]" << endl;
+}
+
+int connectTo(const Target& target) {
+    int fd;
+    if (!target.unixPath.empty()) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, target.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(uint16_t(target.tcpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+        int one = 1;
+        if (fd >= 0) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+bool sendLine(int fd, const string& line) {
+    string data = line + "\n";
+    return ::send(fd, data.data(), data.size(), MSG_NOSIGNAL) == ssize_t(data.size());
+}
+
+// Conexão de controle bloqueante: "stats" e a linha de resposta
+bool queryStats(const Target& target, uint64_t& games, uint64_t& moves, int64_t& cpuMicros) {
+    int fd = connectTo(target);
+    if (fd < 0 || !sendLine(fd, "stats")) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    string line;
+    char c;
+    while (read(fd, &c, 1) == 1 && c != '\n') line += c;
+    close(fd);
+
+    istringstream fields(line);
+    string stats, sessionsLabel, gamesLabel, movesLabel, cpuLabel;
+    uint64_t sessions;
+    fields >> stats >> sessionsLabel >> sessions >> gamesLabel >> games >> movesLabel >> moves >> cpuLabel >> cpuMicros;
+    return bool(fields) && stats == "stats" && cpuLabel == "cpu_us";
+}
+
+string formatMove(int cell) {
+    return string(1, char('a' + cell % 3)) + to_string(cell / 3 + 1);
+}
+
+int parseMove(const string& text) {
+    if (text.size() < 2 || text[0] < 'a' || text[0] > 'c' || text[1] < '1' || text[1] > '3') return -1;
+    return (text[1] - '1') * 3 + (text[0] - 'a');
+}
+
+int64_t percentile(const vector<int64_t>& sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    return sorted[size_t(fraction * double(sorted.size() - 1))];
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Target target;
+    int sessionCount = 1000;
+    double seconds = 5.0;
+    int thinkMillis = 0;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--unix" && hasValue) {
+            target.unixPath = argv[++i];
+        } else if (arg == "--tcp" && hasValue) {
+            target.tcpPort = atoi(argv[++i]);
+        } else if (arg == "--sessions" && hasValue) {
+            sessionCount = max(1, atoi(argv[++i]));
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = atof(argv[++i]);
+        } else if (arg == "--think" && hasValue) {
+            thinkMillis = max(0, atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (target.unixPath.empty() && target.tcpPort <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    uint64_t gamesBefore, movesBefore;
+    int64_t cpuBefore;
+    if (!queryStats(target, gamesBefore, movesBefore, cpuBefore)) {
+        cout << "Servidor não respondeu: " << strerror(errno) << endl;
+        return 1;
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<Client> clients(static_cast<size_t>(sessionCount));
+    for (int i = 0; i < sessionCount; ++i) {
+        Client& client = clients[i];
+        client.fd = connectTo(target);
+        if (client.fd < 0) {
+            cout << "Conexão " << i << " falhou: " << strerror(errno) << endl;
+            return 1;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u32 = uint32_t(i);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+    }
+
+    mt19937_64 rng(seed);
+    vector<int64_t> latencies;
+    latencies.reserve(1 << 20);
+    uint64_t errors = 0;
+    deque<pair<Clock::time_point, int>> thinking; // Pausa constante: a fila já sai em ordem de tempo
+
+    auto startGame = [&](Client& client) {
+        client.board = Bitboard();
+        client.side = client.games % 2 ? Player::O : Player::X; // Alterna quem abre
+        client.timing = client.side == Player::O;
+        client.sentAt = Clock::now();
+        sendLine(client.fd, client.side == Player::X ? "new x" : "new o");
+    };
+    auto playRandom = [&](Client& client) {
+        uint16_t empty = uint16_t(client.board.emptyCells());
+        uniform_int_distribution<int> dist(0, __builtin_popcount(empty) - 1);
+        for (int skip = dist(rng); skip > 0; --skip) empty &= uint16_t(empty - 1);
+        int cell = __builtin_ctz(empty);
+        client.board.set(cell / 3, cell % 3, client.side);
+        client.timing = true;
+        client.sentAt = Clock::now();
+        sendLine(client.fd, "play " + formatMove(cell));
+    };
+    // Próximo passo da sessão, agora ou depois da pausa
+    auto schedule = [&](int index) {
+        if (thinkMillis == 0) {
+            Client& client = clients[index];
+            if (client.board.isGameOver()) startGame(client);
+            else playRandom(client);
+        } else {
+            thinking.push_back({Clock::now() + chrono::milliseconds(thinkMillis), index});
+        }
+    };
+
+    // Respostas: "ok", "move b2[ end x|o|draw]", "end x|draw", "error ..."
+    auto handleLine = [&](int index, const string& line) {
+        Client& client = clients[index];
+        if (client.timing && line.compare(0, 5, "move ") == 0) {
+            latencies.push_back(chrono::duration_cast<chrono::microseconds>(Clock::now() - client.sentAt).count());
+        }
+        client.timing = false;
+        if (line.compare(0, 5, "move ") == 0) {
+            int cell = parseMove(line.substr(5, 2));
+            if (cell >= 0) client.board.set(cell / 3, cell % 3, client.side == Player::X ? Player::O : Player::X);
+        } else if (line.compare(0, 5, "error") == 0) {
+            ++errors;
+            startGame(client); // recomeça sem depender do estado do servidor
+            return;
+        } else if (line.compare(0, 3, "end") != 0 && line != "ok") {
+            ++errors;
+        }
+        if (client.board.isGameOver()) ++client.games;
+        schedule(index);
+    };
+
+    Clock::time_point started = Clock::now();
+    Clock::time_point deadline = started + chrono::duration_cast<Clock::duration>(chrono::duration<double>(seconds));
+    for (Client& client : clients) startGame(client);
+
+    epoll_event events[256];
+    char buffer[4096];
+    for (;;) {
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) break;
+        while (!thinking.empty() && thinking.front().first <= now) {
+            int index = thinking.front().second;
+            thinking.pop_front();
+            Client& client = clients[index];
+            if (client.board.isGameOver()) startGame(client);
+            else playRandom(client);
+        }
+
+        Clock::time_point wakeAt = thinking.empty() ? deadline : min(deadline, thinking.front().first);
+        int timeout = int(chrono::duration_cast<chrono::milliseconds>(wakeAt - now).count()) + 1;
+        int count = epoll_wait(epollFd, events, 256, timeout);
+        for (int i = 0; i < count; ++i) {
+            int index = int(events[i].data.u32);
+            Client& client = clients[index];
+            ssize_t received = read(client.fd, buffer, sizeof(buffer));
+            if (received <= 0) {
+                cout << "Servidor fechou a conexão " << index << endl;
+                return 1;
+            }
+            client.input.append(buffer, size_t(received));
+            size_t end;
+            while ((end = client.input.find('\n')) != string::npos) {
+                string line = client.input.substr(0, end);
+                client.input.erase(0, end + 1);
+                handleLine(index, line);
+            }
+        }
+    }
+    double elapsed = chrono::duration<double>(Clock::now() - started).count();
+
+    uint64_t gamesAfter, movesAfter;
+    int64_t cpuAfter;
+    bool haveStats = queryStats(target, gamesAfter, movesAfter, cpuAfter);
+    for (Client& client : clients) close(client.fd);
+    close(epollFd);
+
+    sort(latencies.begin(), latencies.end());
+    double serverCores = haveStats ? double(cpuAfter - cpuBefore) / 1e6 / elapsed : 0.0;
+
+    cout << fixed << setprecision(1);
+    cout << "Sessões: " << sessionCount << ", " << elapsed << " s, pausa " << thinkMillis << " ms" << endl;
+    cout << "Jogadas da IA: " << latencies.size() << " (" << latencies.size() / elapsed << " por s)";
+    if (haveStats) cout << ", partidas: " << gamesAfter - gamesBefore;
+    cout << ", erros: " << errors << endl;
+    cout << "Latência por jogada: p50 " << percentile(latencies, 0.5) << " us, p99 "
+         << percentile(latencies, 0.99) << " us, max " << (latencies.empty() ? 0 : latencies.back()) << " us" << endl;
+    if (haveStats && serverCores > 0) {
+        cout << setprecision(3) << "CPU do servidor: " << serverCores << " núcleos em média" << endl;
+        cout << setprecision(0) << "Sessões por núcleo: " << sessionCount / serverCores
+             << ", jogadas por s por núcleo: " << latencies.size() / elapsed / serverCores << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "SelfPlay.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Simulador de partidas IA x IA, sem SFML.
+// Uso: selfplay [--games N] [--threads T] [--seed S] [--board 3|4|5|15]
+//               [--nodes N] [--playouts N] [--endgame DIR] [--match X:O]...
+// Exemplo: selfplay --games 1000000 --match easy:hard --match medium:medium
+
+namespace {
+
+void printUsage() {
+    cout << "Uso: selfplay [--games N] [--threads T] [--seed S] [--board 3|4|5|15]" << endl;
+    cout << "              [--nodes N] [--playouts N] [--endgame DIR] [--match X:O]..." << endl;
+    cout << "  X e O: easy|medium|hard|mcts (padrão: todos os confrontos)" << endl;
+}
+
+double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * double(part) / double(total) : 0.0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    SelfPlayOptions options;
+    options.limits.maxNodes = 20000; // tabuleiros grandes: orçamento por nós, reprodutível
+    options.mctsLimits.playouts = 2000;
+    vector<MatchConfig> matches;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue) {
+            options.gamesPerMatch = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--nodes" && hasValue) {
+            options.limits.maxNodes = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--playouts" && hasValue) {
+            options.mctsLimits.playouts = uint32_t(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--endgame" && hasValue) {
+            options.endgameDirectory = argv[++i];
+        } else if (arg == "--board" && hasValue) {
+            int size = atoi(argv[++i]);
+            options.boardOption = size == 4 ? 1 : size == 5 ? 2 : size == 15 ? 3 : 0;
+        } else if (arg == "--match" && hasValue) {
+            string spec = argv[++i];
+            size_t colon = spec.find(':');
+            MatchConfig match;
+            if (colon == string::npos ||
+                !SelfPlay::parseDifficulty(spec.substr(0, colon), match.x) ||
+                !SelfPlay::parseDifficulty(spec.substr(colon + 1), match.o)) {
+                cout << "Confronto inválido: " << spec << endl;
+                printUsage();
+                return 1;
+            }
+            matches.push_back(match);
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (matches.empty()) {
+        const Difficulty all[] = { Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD };
+        for (Difficulty x : all) {
+            for (Difficulty o : all) matches.push_back({ x, o });
+        }
+    }
+
+    SelfPlay selfPlay(options);
+    cout << "=== SIMULADOR IA x IA ===" << endl;
+    cout << "Partidas por confronto: " << options.gamesPerMatch
+         << " | Threads: " << selfPlay.getThreads()
+         << " | Semente: " << options.seed << endl << endl;
+
+    cout << left << setw(9) << "X" << setw(9) << "O"
+         << right << setw(11) << "Partidas" << setw(10) << "X vence"
+         << setw(10) << "Empate" << setw(10) << "O vence"
+         << setw(10) << "Inválid." << setw(14) << "Partidas/s" << endl;
+
+    uint64_t totalGames = 0;
+    double totalSeconds = 0.0;
+    cout << fixed;
+    for (const MatchConfig& match : matches) {
+        MatchResult result = selfPlay.play(match);
+        totalGames += result.games;
+        totalSeconds += result.seconds;
+
+        cout << left << setw(9) << SelfPlay::difficultyName(match.x)
+             << setw(9) << SelfPlay::difficultyName(match.o)
+             << right << setw(11) << result.games
+             << setprecision(1)
+             << setw(9) << percent(result.xWins, result.games) << "%"
+             << setw(9) << percent(result.draws, result.games) << "%"
+             << setw(9) << percent(result.oWins, result.games) << "%"
+             << setw(10) << result.illegalMoves
+             << setprecision(0)
+             << setw(14) << (result.seconds > 0 ? result.games / result.seconds : 0.0) << endl;
+    }
+
+    cout << endl << "Total: " << totalGames << " partidas em " << setprecision(2) << totalSeconds
+         << " s (" << setprecision(0) << (totalSeconds > 0 ? totalGames / totalSeconds : 0.0)
+         << " partidas/s)" << endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "GameServer.h"
+#include "Logger.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+using namespace std;
+
+// Servidor local de partidas 3x3 (Linux), sem SFML.
+// Uso: server [--unix CAMINHO] [--tcp PORTA] [--workers N] [--seed S] [--log NIVEL]
+// Exemplo: server --unix /tmp/velha.sock --tcp 7777
+// Veja GameServer.h para o protocolo; loadgen mede a latência das jogadas.
+
+namespace {
+
+GameServer* running = nullptr;
+
+void handleSignal(int) {
+    if (running) running->stop();
+}
+
+void printUsage() {
+    cout << "Uso: server [--unix CAMINHO] [--tcp PORTA] [--workers N] [--seed S] [--log NIVEL]" << endl;
+}
+
+// Milhares de conexões: sobe o limite de descritores até o máximo permitido
+void raiseDescriptorLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--unix" && hasValue) {
+            options.unixPath = argv[++i];
+        } else if (arg == "--tcp" && hasValue) {
+            options.tcpPort = atoi(argv[++i]);
+        } else if (arg == "--workers" && hasValue) {
+            options.workers = atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--log" && hasValue) {
+            LogLevel level;
+            if (!Logger::parseLevel(argv[++i], level)) {
+                cout << "Nível de log desconhecido: " << argv[i] << endl;
+                return 1;
+            }
+            Logger::setLevel(level);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.unixPath.empty() && options.tcpPort <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    raiseDescriptorLimit();
+    GameServer server(options);
+    if (!server.start()) return 1;
+
+    running = &server;
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+    server.run();
+    running = nullptr;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "RetrogradeSolver.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// Gerador do banco de finais por análise retrógrada, sem SFML.
+// Uso: solve [--board 3x3k3|4x4k3|4x4k4|5x5k4] [--dir DIRETÓRIO] [--threads T] [--book] [--verify]
+// Exemplo: solve --board 4x4k4 --dir endgame --book
+// --book grava também DIRETÓRIO/4x4k4.book (livro mapeado pela IA);
+// --verify só confere o checksum de um livro já gravado.
+// O diretório precisa existir; o 5x5 (K4) ocupa ~160 GB e leva dias.
+
+namespace {
+
+void printUsage() {
+    cout << "Uso: solve [--board 3x3k3|4x4k3|4x4k4|5x5k4] [--dir DIRETÓRIO] [--threads T] [--book] [--verify]" << endl;
+}
+
+template <int Rows, int Cols, int K>
+int run(const string& directory, int threads, bool writeBook, bool verifyOnly) {
+    string bookPath = book::bookPath(directory, Rows, Cols, K);
+    if (verifyOnly) {
+        PositionBook<Rows, Cols, K> positionBook;
+        bool valid = positionBook.open(bookPath) && positionBook.verify();
+        cout << bookPath << (valid ? ": íntegro" : ": inválido ou corrompido") << endl;
+        return valid ? 0 : 1;
+    }
+
+    RetrogradeSolver<Rows, Cols, K> solver(threads);
+    cout << "=== ANÁLISE RETRÓGRADA " << Rows << "x" << Cols << " (K" << K << ") ===" << endl;
+
+    auto start = chrono::steady_clock::now();
+    if (!solver.solve(directory, writeBook ? bookPath : string())) return 1;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const LayerStats& root = solver.getStats().back();
+    cout << endl << "Posição inicial: "
+         << (root.wins ? "X vence" : root.draws ? "empate" : "O vence") << " | " << seconds << " s" << endl;
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    string board = "4x4k4";
+    string directory = "endgame";
+    int threads = 0;
+    bool writeBook = false;
+    bool verifyOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--board" && hasValue) {
+            board = argv[++i];
+        } else if (arg == "--dir" && hasValue) {
+            directory = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--book") {
+            writeBook = true;
+        } else if (arg == "--verify") {
+            verifyOnly = true;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (board == "3x3k3") return run<3, 3, 3>(directory, threads, writeBook, verifyOnly);
+    if (board == "4x4k3") return run<4, 4, 3>(directory, threads, writeBook, verifyOnly);
+    if (board == "4x4k4") return run<4, 4, 4>(directory, threads, writeBook, verifyOnly);
+    if (board == "5x5k4") return run<5, 5, 4>(directory, threads, writeBook, verifyOnly);
+    printUsage();
+    return 1;
+}